@@ -0,0 +1,148 @@
+#ifndef TEST_BENCH_H
+#define TEST_BENCH_H
+
+/*
+ * Minimal micro-benchmark support for the hosted environments.
+ *
+ * Instruction and cycle counts are read from Linux perf_event, restricted to
+ * user mode.  Where perf_event isn't available (old kernels, containers with
+ * a restrictive perf_event_paranoid) the counters report themselves invalid
+ * and results are printed as -1, so that scripts consuming the output can
+ * tell "missing" from "fast."
+ *
+ * Results are printed one per line as comma-separated values:
+ *
+ *   name,ops,instructions_per_op,cycles_per_op
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace bench {
+
+/*
+ * Prevents the compiler from discarding a computed value, or from assuming
+ * anything about the contents of memory it can reach.
+ */
+template <typename T>
+inline void keep(T const & value) {
+  asm volatile("" : : "m"(value) : "memory");
+}
+
+/*
+ * Prevents the compiler from propagating constants through a value, so that
+ * benchmark inputs aren't folded away.
+ */
+template <typename T>
+inline T opaque(T value) {
+  asm volatile("" : "+m"(value) : : "memory");
+  return value;
+}
+
+/*
+ * A single user-mode hardware counter.
+ */
+class Counter {
+ public:
+  explicit Counter(std::uint64_t config) : _fd(open_counter(config)) {}
+
+  ~Counter() {
+    if (_fd >= 0) close(_fd);
+  }
+
+  Counter(Counter const &) = delete;
+  Counter & operator=(Counter const &) = delete;
+
+  bool is_valid() const { return _fd >= 0; }
+
+  void start() {
+    if (_fd < 0) return;
+    ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  std::uint64_t stop() {
+    if (_fd < 0) return 0;
+    ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+
+    std::uint64_t count = 0;
+    if (read(_fd, &count, sizeof(count)) != sizeof(count)) return 0;
+    return count;
+  }
+
+ private:
+  int _fd;
+
+  static int open_counter(std::uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+};
+
+/*
+ * Runs 'fn' 'iterations' times under both counters and prints a result line.
+ * 'fn' receives the iteration number, which it should fold into its work to
+ * keep the loop from being hoisted.
+ *
+ * For bulk benchmarks, where each call to 'fn' performs 'ops_per_call'
+ * operations, results are reported per operation rather than per call.
+ */
+template <typename Fn>
+void run(char const * name,
+         unsigned long iterations,
+         unsigned long ops_per_call,
+         Fn && fn) {
+  Counter instructions(PERF_COUNT_HW_INSTRUCTIONS);
+  Counter cycles(PERF_COUNT_HW_CPU_CYCLES);
+
+  // Warm caches and predictors before measuring.
+  for (unsigned long i = 0; i < iterations / 16 + 1; ++i) fn(i);
+
+  instructions.start();
+  cycles.start();
+  for (unsigned long i = 0; i < iterations; ++i) fn(i);
+  auto c = cycles.stop();
+  auto n = instructions.stop();
+
+  auto const ops = static_cast<double>(iterations)
+                 * static_cast<double>(ops_per_call);
+  auto per_op = [ops] (Counter const & counter, std::uint64_t count) {
+    return counter.is_valid() ? static_cast<double>(count) / ops : -1.;
+  };
+
+  std::printf("%s,%lu,%.2f,%.2f\n",
+              name,
+              iterations * ops_per_call,
+              per_op(instructions, n),
+              per_op(cycles, c));
+}
+
+template <typename Fn>
+void run(char const * name, unsigned long iterations, Fn && fn) {
+  run(name, iterations, 1, fn);
+}
+
+/*
+ * Prints the header line matching the output of run.
+ */
+inline void print_header() {
+  std::printf("name,ops,instructions_per_op,cycles_per_op\n");
+}
+
+}  // namespace bench
+
+#endif  // TEST_BENCH_H
@@ -0,0 +1,19 @@
+#ifndef TEST_BIFFIELD_ATOMIC_H_
+#define TEST_BIFFIELD_ATOMIC_H_
+
+#include <stdint.h>
+
+#include "etl/biffield/atomic.h"
+
+/*
+ * The example registers, generated with the atomic access policy.
+ */
+struct AtomicExample {
+  #define ETL_BFF_DEFINITION_FILE "test/biffield/example.reg"
+  #define ETL_BFF_ACCESS_POLICY ::etl::biffield::AtomicAccess
+  #include <etl/biffield/generate.h>
+  #undef ETL_BFF_ACCESS_POLICY
+  #undef ETL_BFF_DEFINITION_FILE
+};
+
+#endif  // TEST_BIFFIELD_ATOMIC_H_
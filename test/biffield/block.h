@@ -0,0 +1,15 @@
+#ifndef TEST_BIFFIELD_BLOCK_H_
+#define TEST_BIFFIELD_BLOCK_H_
+
+#include <stdint.h>
+
+/*
+ * A multi-register block, for exercising operations that span registers.
+ */
+struct Block {
+  #define ETL_BFF_DEFINITION_FILE "test/biffield/block.reg"
+  #include <etl/biffield/generate.h>
+  #undef ETL_BFF_DEFINITION_FILE
+};
+
+#endif  // TEST_BIFFIELD_BLOCK_H_
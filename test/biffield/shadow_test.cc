@@ -0,0 +1,260 @@
+#include <stdint.h>
+
+#include <gtest/gtest.h>
+
+#include "test/biffield/block.h"
+
+/*
+ * Tests for shadowed and batched register access.  Most run against plain
+ * memory and check results; the traffic tests at the end generate the block
+ * with a counting access policy, to count the accesses that actually reach
+ * the registers.
+ */
+
+/*
+ * Compile-time test cases.
+ */
+
+static_assert(sizeof(Block) == 3 * sizeof(uint32_t),
+              "Generated helper types must not change the register layout.");
+
+/*
+ * Dynamic test cases.
+ */
+
+class BiffieldShadow : public ::testing::Test {
+protected:
+  Block blk;
+
+  virtual void SetUp() {
+    blk.write_ctrl(Block::ctrl_value_t()
+                   .with_prescale(0x12)
+                   .with_mode(0x3)
+                   .with_flags(0x4));
+    blk.write_status(Block::status_value_t().with_all(0xCAFEF00D));
+    blk.write_data(Block::data_value_t().with_hi(0xDEAD).with_lo(0xBEEF));
+  }
+};
+
+TEST_F(BiffieldShadow, ConstructionSnapshotsRegisters) {
+  Block::Shadow s(blk);
+
+  EXPECT_EQ(0x12, s.read_ctrl().get_prescale());
+  EXPECT_EQ(0x3, s.read_ctrl().get_mode());
+  EXPECT_EQ(0x4, s.read_ctrl().get_flags());
+  EXPECT_EQ(0xCAFEF00Du, s.read_status().get_all());
+  EXPECT_EQ(0xDEAD, s.read_data().get_hi());
+  EXPECT_EQ(0xBEEF, s.read_data().get_lo());
+  EXPECT_FALSE(s.is_dirty());
+}
+
+TEST_F(BiffieldShadow, WritesDeferredUntilFlush) {
+  Block::Shadow s(blk);
+
+  s.write_data(Block::data_value_t().with_hi(0x600D).with_lo(0xF00D));
+  EXPECT_TRUE(s.is_dirty());
+  EXPECT_EQ(0x600D, s.read_data().get_hi())
+    << "Shadow reads must observe shadow writes.";
+  EXPECT_EQ(0xDEAD, blk.read_data().get_hi())
+    << "Shadow writes must not reach the registers before flush.";
+
+  s.flush();
+  EXPECT_FALSE(s.is_dirty());
+  EXPECT_EQ(0x600D, blk.read_data().get_hi());
+  EXPECT_EQ(0xF00D, blk.read_data().get_lo());
+}
+
+TEST_F(BiffieldShadow, UpdateUsesCachedValue) {
+  Block::Shadow s(blk);
+
+  s.update_ctrl([] (Block::ctrl_value_t v) { return v.with_mode(0xA); });
+  s.update_ctrl([] (Block::ctrl_value_t v) { return v.with_flags(0x1); });
+  s.flush();
+
+  auto ctrl = blk.read_ctrl();
+  EXPECT_EQ(0x12, ctrl.get_prescale());
+  EXPECT_EQ(0xA, ctrl.get_mode());
+  EXPECT_EQ(0x1, ctrl.get_flags());
+}
+
+TEST_F(BiffieldShadow, FlushWritesOnlyDirtyRegisters) {
+  Block::Shadow s(blk);
+  s.update_ctrl([] (Block::ctrl_value_t v) { return v.with_mode(0xF); });
+
+  // Change a register behind the shadow's back; a clean shadow register must
+  // not clobber it on flush.
+  blk.write_status(Block::status_value_t().with_all(0x5A5A5A5A));
+
+  s.flush();
+  EXPECT_EQ(0xF, blk.read_ctrl().get_mode());
+  EXPECT_EQ(0x5A5A5A5Au, blk.read_status().get_all());
+  EXPECT_EQ(0xDEAD, blk.read_data().get_hi());
+}
+
+TEST_F(BiffieldShadow, SecondFlushWritesNothing) {
+  Block::Shadow s(blk);
+  s.write_status(Block::status_value_t().with_all(1));
+  s.flush();
+
+  blk.write_status(Block::status_value_t().with_all(2));
+  s.flush();
+  EXPECT_EQ(2u, blk.read_status().get_all())
+    << "Flush must clear dirty state.";
+}
+
+class BiffieldWriteMany : public BiffieldShadow {};
+
+TEST_F(BiffieldWriteMany, WritesEveryRegisterGiven) {
+  blk.write_many(Block::ctrl_value_t().with_mode(0x7),
+                 Block::data_value_t().with_hi(0x1111).with_lo(0x2222));
+
+  EXPECT_EQ(0x7, blk.read_ctrl().get_mode());
+  EXPECT_EQ(0x0, blk.read_ctrl().get_prescale())
+    << "write_many writes whole registers, like write_*.";
+  EXPECT_EQ(0xCAFEF00Du, blk.read_status().get_all())
+    << "Registers not given must be left alone.";
+  EXPECT_EQ(0x1111, blk.read_data().get_hi());
+  EXPECT_EQ(0x2222, blk.read_data().get_lo());
+}
+
+TEST_F(BiffieldWriteMany, ArgumentOrderDoesNotMatter) {
+  blk.write_many(Block::data_value_t().with_lo(0x3333),
+                 Block::status_value_t().with_all(0x44444444),
+                 Block::ctrl_value_t().with_flags(0x5));
+
+  EXPECT_EQ(0x5, blk.read_ctrl().get_flags());
+  EXPECT_EQ(0x44444444u, blk.read_status().get_all());
+  EXPECT_EQ(0x3333, blk.read_data().get_lo());
+}
+
+TEST_F(BiffieldWriteMany, SingleRegister) {
+  blk.write_many(Block::status_value_t().with_all(0x0BADC0DE));
+  EXPECT_EQ(0x0BADC0DEu, blk.read_status().get_all());
+}
+
+/*
+ * Bus traffic.  generate.h sends every register load and store through the
+ * access policy's read and write; this one just counts them.
+ */
+
+struct CountingAccess {
+  static unsigned reads, writes;
+
+  static void reset() {
+    reads = writes = 0;
+  }
+
+  template <typename T>
+  static T read(T const volatile & reg) {
+    ++reads;
+    return reg;
+  }
+
+  template <typename T>
+  static void write(T volatile & reg, T value) {
+    ++writes;
+    reg = value;
+  }
+};
+
+unsigned CountingAccess::reads;
+unsigned CountingAccess::writes;
+
+struct CountedBlock {
+  #define ETL_BFF_DEFINITION_FILE "test/biffield/block.reg"
+  #define ETL_BFF_ACCESS_POLICY ::CountingAccess
+  #include <etl/biffield/generate.h>
+  #undef ETL_BFF_ACCESS_POLICY
+  #undef ETL_BFF_DEFINITION_FILE
+};
+
+class BiffieldShadowTraffic : public ::testing::Test {
+protected:
+  CountedBlock blk;
+
+  virtual void SetUp() {
+    CountingAccess::reset();
+  }
+};
+
+TEST_F(BiffieldShadowTraffic, ConstructionReadsEachRegisterOnce) {
+  CountedBlock::Shadow s(blk);
+  EXPECT_EQ(3u, CountingAccess::reads);
+  EXPECT_EQ(0u, CountingAccess::writes);
+}
+
+TEST_F(BiffieldShadowTraffic, ShadowAccessIsFree) {
+  CountedBlock::Shadow s(blk);
+  CountingAccess::reset();
+
+  s.read_ctrl();
+  s.write_data(CountedBlock::data_value_t().with_hi(1));
+  s.update_ctrl([] (CountedBlock::ctrl_value_t v) { return v.with_mode(2); });
+  EXPECT_EQ(0u, CountingAccess::reads);
+  EXPECT_EQ(0u, CountingAccess::writes);
+}
+
+TEST_F(BiffieldShadowTraffic, FieldWritesMergeIntoOneWrite) {
+  CountedBlock::Shadow s(blk);
+  CountingAccess::reset();
+
+  s.update_ctrl([] (CountedBlock::ctrl_value_t v) {
+    return v.with_prescale(0x21);
+  });
+  s.update_ctrl([] (CountedBlock::ctrl_value_t v) {
+    return v.with_mode(0x4);
+  });
+  s.update_ctrl([] (CountedBlock::ctrl_value_t v) {
+    return v.with_flags(0x9);
+  });
+  s.flush();
+
+  EXPECT_EQ(0u, CountingAccess::reads);
+  EXPECT_EQ(1u, CountingAccess::writes)
+    << "Writes to fields of one register must reach the bus as one write.";
+
+  auto ctrl = blk.read_ctrl();
+  EXPECT_EQ(0x21, ctrl.get_prescale());
+  EXPECT_EQ(0x4, ctrl.get_mode());
+  EXPECT_EQ(0x9, ctrl.get_flags());
+}
+
+TEST_F(BiffieldShadowTraffic, FlushWritesEachDirtyRegisterOnce) {
+  CountedBlock::Shadow s(blk);
+  CountingAccess::reset();
+
+  s.update_ctrl([] (CountedBlock::ctrl_value_t v) { return v.with_mode(1); });
+  s.update_ctrl([] (CountedBlock::ctrl_value_t v) { return v.with_flags(2); });
+  s.write_data(CountedBlock::data_value_t().with_lo(3));
+  s.flush();
+
+  EXPECT_EQ(0u, CountingAccess::reads);
+  EXPECT_EQ(2u, CountingAccess::writes);
+}
+
+TEST_F(BiffieldShadowTraffic, CleanFlushWritesNothing) {
+  CountedBlock::Shadow s(blk);
+  CountingAccess::reset();
+
+  s.flush();
+  EXPECT_EQ(0u, CountingAccess::writes);
+
+  s.write_status(CountedBlock::status_value_t().with_all(1));
+  s.flush();
+  s.flush();
+  EXPECT_EQ(1u, CountingAccess::writes);
+}
+
+TEST_F(BiffieldShadowTraffic, WriteManyWritesEachRegisterOnce) {
+  blk.write_many(CountedBlock::ctrl_value_t().with_mode(0x7),
+                 CountedBlock::data_value_t().with_hi(0x1111));
+  EXPECT_EQ(0u, CountingAccess::reads)
+    << "write_many writes whole registers and must not read them.";
+  EXPECT_EQ(2u, CountingAccess::writes);
+
+  CountingAccess::reset();
+  blk.write_many(CountedBlock::data_value_t().with_lo(1),
+                 CountedBlock::status_value_t().with_all(2),
+                 CountedBlock::ctrl_value_t().with_flags(3));
+  EXPECT_EQ(3u, CountingAccess::writes);
+}
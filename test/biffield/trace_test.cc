@@ -0,0 +1,182 @@
+#include <stdint.h>
+
+#include <gtest/gtest.h>
+
+#include "etl/biffield/trace.h"
+
+#include "test/biffield/traced.h"
+
+/*
+ * Tests for the tracing access policy and its simulated side effects.
+ *
+ * Side effects are keyed by register address, so two instances of the same
+ * block can be given different behavior.  block.reg's registers are
+ * consecutive words with no padding, so their addresses are computed from
+ * the block's base.
+ */
+
+using etl::biffield::Access;
+using etl::biffield::Trace;
+
+static_assert(sizeof(TracedBlock) == 3 * sizeof(uint32_t),
+              "The tracing policy must not change the register layout.");
+
+class BiffieldTrace : public ::testing::Test {
+protected:
+  TracedExample ex;
+  TracedBlock blk;
+
+  Trace & trace = Trace::get();
+
+  virtual void SetUp() {
+    trace.reset();
+  }
+
+  static uintptr_t register_address(TracedBlock const & b, unsigned index) {
+    return reinterpret_cast<uintptr_t>(&b) + index * sizeof(uint32_t);
+  }
+
+  uintptr_t status_address() {
+    return register_address(blk, 1);
+  }
+
+  static TracedExample::foo_value_t deadbeef() {
+    return TracedExample::foo_value_t().with_top(0xDEAD).with_bottom(0xBEEF);
+  }
+};
+
+TEST_F(BiffieldTrace, EmptyAfterReset) {
+  EXPECT_EQ(0u, trace.accesses().count());
+  EXPECT_EQ(0u, trace.read_count());
+  EXPECT_EQ(0u, trace.write_count());
+}
+
+TEST_F(BiffieldTrace, WriteRecorded) {
+  ex.write_foo(deadbeef());
+
+  ASSERT_EQ(1u, trace.accesses().count());
+  auto const & a = trace.accesses()[0];
+  EXPECT_EQ(Access::Kind::write, a.kind);
+  EXPECT_STREQ("foo", a.name);
+  EXPECT_EQ(0xDEADBEEFu, a.value);
+  EXPECT_EQ(0u, trace.read_count());
+  EXPECT_EQ(1u, trace.write_count());
+}
+
+TEST_F(BiffieldTrace, ReadRecorded) {
+  ex.write_foo(deadbeef());
+  trace.reset();
+
+  EXPECT_EQ(0xDEADBEEFu, ex.read_foo().get_all())
+    << "Tracing must not change the behavior of plain registers.";
+
+  ASSERT_EQ(1u, trace.accesses().count());
+  auto const & a = trace.accesses()[0];
+  EXPECT_EQ(Access::Kind::read, a.kind);
+  EXPECT_STREQ("foo", a.name);
+  EXPECT_EQ(0xDEADBEEFu, a.value);
+}
+
+TEST_F(BiffieldTrace, UpdateIsReadThenWrite) {
+  ex.write_foo(deadbeef());
+  trace.reset();
+
+  ex.update_foo([] (TracedExample::foo_value_t v) {
+      return v.with_top(0x600D);
+  });
+
+  ASSERT_EQ(2u, trace.accesses().count());
+  EXPECT_EQ(Access::Kind::read, trace.accesses()[0].kind);
+  EXPECT_EQ(0xDEADBEEFu, trace.accesses()[0].value);
+  EXPECT_EQ(Access::Kind::write, trace.accesses()[1].kind);
+  EXPECT_EQ(0x600DBEEFu, trace.accesses()[1].value);
+}
+
+TEST_F(BiffieldTrace, DistinguishesRegisters) {
+  blk.write_ctrl(TracedBlock::ctrl_value_t().with_mode(1));
+  blk.read_data();
+
+  ASSERT_EQ(2u, trace.accesses().count());
+  EXPECT_STREQ("ctrl", trace.accesses()[0].name);
+  EXPECT_STREQ("data", trace.accesses()[1].name);
+  EXPECT_EQ(register_address(blk, 0), trace.accesses()[0].address);
+  EXPECT_EQ(register_address(blk, 2), trace.accesses()[1].address);
+}
+
+TEST_F(BiffieldTrace, CountsSurviveOverflow) {
+  std::size_t const n = Trace::capacity + 10;
+  for (std::size_t i = 0; i < n; ++i) {
+    ex.write_foo(deadbeef());
+  }
+
+  EXPECT_EQ(n, trace.write_count())
+    << "Counts must keep going after the buffer fills.";
+  EXPECT_EQ(Trace::capacity, trace.accesses().count())
+    << "The buffer should keep the first accesses, not the last.";
+  EXPECT_TRUE(trace.overflowed());
+}
+
+/*
+ * Simulated side effects.
+ */
+
+TEST_F(BiffieldTrace, ReadToClear) {
+  blk.write_status(TracedBlock::status_value_t().with_all(0x000000F0));
+  trace.set_read_to_clear(status_address(), 0x000000FF);
+
+  EXPECT_EQ(0x000000F0u, blk.read_status().get_all());
+  EXPECT_EQ(0u, blk.read_status().get_all())
+    << "Masked bits must clear after being read.";
+}
+
+TEST_F(BiffieldTrace, ReadToClearPartialMask) {
+  blk.write_status(TracedBlock::status_value_t().with_all(0xAA0000F0));
+  trace.set_read_to_clear(status_address(), 0x000000FF);
+
+  blk.read_status();
+  EXPECT_EQ(0xAA000000u, blk.read_status().get_all())
+    << "Bits outside the mask must be unaffected by reads.";
+}
+
+TEST_F(BiffieldTrace, WriteOneToClear) {
+  blk.write_status(TracedBlock::status_value_t().with_all(0x000000FF));
+  trace.set_write_one_to_clear(status_address(), 0x0000FFFF);
+
+  blk.write_status(TracedBlock::status_value_t().with_all(0x00AA000F));
+  EXPECT_EQ(0x00AA00F0u, blk.read_status().get_all())
+    << "Masked bits clear where 1 is written; others take the written value.";
+}
+
+TEST_F(BiffieldTrace, WriteOneToClearCatchesNaiveUpdate) {
+  // A read-modify-write of a W1C register acknowledges every pending bit,
+  // not just the one the caller changed.  This is the sort of driver bug the
+  // simulation exists to expose.
+  blk.write_status(TracedBlock::status_value_t().with_all(0x0000000F));
+  trace.set_write_one_to_clear(status_address(), 0x0000FFFF);
+
+  blk.update_status([] (TracedBlock::status_value_t v) { return v; });
+  EXPECT_EQ(0u, blk.read_status().get_all());
+}
+
+TEST_F(BiffieldTrace, ResetClearsSideEffects) {
+  trace.set_read_to_clear(status_address(), 0xFFFFFFFF);
+  trace.reset();
+
+  blk.write_status(TracedBlock::status_value_t().with_all(7));
+  blk.read_status();
+  EXPECT_EQ(7u, blk.read_status().get_all());
+}
+
+TEST_F(BiffieldTrace, SideEffectsArePerInstance) {
+  TracedBlock other;
+  blk.write_status(TracedBlock::status_value_t().with_all(0xF));
+  other.write_status(TracedBlock::status_value_t().with_all(0xF));
+  trace.set_read_to_clear(status_address(), 0xFFFFFFFF);
+
+  other.read_status();
+  EXPECT_EQ(0xFu, other.read_status().get_all())
+    << "Side effects must not leak to other instances of the same block.";
+
+  blk.read_status();
+  EXPECT_EQ(0u, blk.read_status().get_all());
+}
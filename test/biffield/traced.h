@@ -0,0 +1,29 @@
+#ifndef TEST_BIFFIELD_TRACED_H_
+#define TEST_BIFFIELD_TRACED_H_
+
+#include <stdint.h>
+
+#include "etl/biffield/trace.h"
+
+/*
+ * The same register definitions as example.h and block.h, generated with the
+ * tracing access policy so that every access is recorded.
+ */
+
+struct TracedExample {
+  #define ETL_BFF_DEFINITION_FILE "test/biffield/example.reg"
+  #define ETL_BFF_ACCESS_POLICY ::etl::biffield::TracingAccess
+  #include <etl/biffield/generate.h>
+  #undef ETL_BFF_ACCESS_POLICY
+  #undef ETL_BFF_DEFINITION_FILE
+};
+
+struct TracedBlock {
+  #define ETL_BFF_DEFINITION_FILE "test/biffield/block.reg"
+  #define ETL_BFF_ACCESS_POLICY ::etl::biffield::TracingAccess
+  #include <etl/biffield/generate.h>
+  #undef ETL_BFF_ACCESS_POLICY
+  #undef ETL_BFF_DEFINITION_FILE
+};
+
+#endif  // TEST_BIFFIELD_TRACED_H_
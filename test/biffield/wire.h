@@ -0,0 +1,29 @@
+#ifndef TEST_BIFFIELD_WIRE_H_
+#define TEST_BIFFIELD_WIRE_H_
+
+#include <stdint.h>
+
+#include "etl/biffield/wire.h"
+
+/*
+ * The UDP header layout, generated as wire-format codecs in both byte orders
+ * from the same definition file.
+ */
+
+struct UdpBe {
+  #define ETL_BFF_DEFINITION_FILE "test/biffield/udp.reg"
+  #define ETL_BFF_WIRE_ENDIAN ::etl::biffield::Endian::big
+  #include <etl/biffield/generate_wire.h>
+  #undef ETL_BFF_WIRE_ENDIAN
+  #undef ETL_BFF_DEFINITION_FILE
+};
+
+struct UdpLe {
+  #define ETL_BFF_DEFINITION_FILE "test/biffield/udp.reg"
+  #define ETL_BFF_WIRE_ENDIAN ::etl::biffield::Endian::little
+  #include <etl/biffield/generate_wire.h>
+  #undef ETL_BFF_WIRE_ENDIAN
+  #undef ETL_BFF_DEFINITION_FILE
+};
+
+#endif  // TEST_BIFFIELD_WIRE_H_
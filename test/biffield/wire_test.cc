@@ -0,0 +1,122 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+
+#include "test/biffield/wire.h"
+
+/*
+ * Tests for wire-format codecs generated from register definitions.
+ */
+
+using etl::data::RangePtr;
+
+// src=12345 dst=53 length=28 checksum=0xABCD, in network byte order.
+static constexpr uint8_t udp_be_bytes[] {
+  0x30, 0x39,  0x00, 0x35,  0x00, 0x1C,  0xAB, 0xCD,
+};
+
+// The same header with each 32-bit word stored little-endian.
+static constexpr uint8_t udp_le_bytes[] {
+  0x35, 0x00,  0x39, 0x30,  0xCD, 0xAB,  0x1C, 0x00,
+};
+
+/*
+ * Compile-time test cases.
+ */
+
+static_assert(UdpBe::size == 8, "Size must cover every word in the file.");
+static_assert(UdpLe::size == 8, "Size must not depend on byte order.");
+
+// Value types are shared with register generation, and are literal types.
+static constexpr auto ports_v = UdpBe::ports_value_t()
+                                .with_src(12345)
+                                .with_dst(53);
+static_assert(ports_v.get_all() == 0x30390035, "");
+
+// Decoding is constexpr over constant data.
+static constexpr UdpBe::ConstView udp_be_view(udp_be_bytes);
+static_assert(udp_be_view.read_ports().get_src() == 12345, "");
+static_assert(udp_be_view.read_ports().get_dst() == 53, "");
+static_assert(udp_be_view.read_len_sum().get_length() == 28, "");
+static_assert(udp_be_view.read_len_sum().get_checksum() == 0xABCD, "");
+
+/*
+ * Dynamic test cases.
+ */
+
+TEST(BiffieldWire, DecodeBigEndian) {
+  UdpBe::ConstView v(udp_be_bytes);
+  EXPECT_EQ(12345, v.read_ports().get_src());
+  EXPECT_EQ(53, v.read_ports().get_dst());
+  EXPECT_EQ(28, v.read_len_sum().get_length());
+  EXPECT_EQ(0xABCD, v.read_len_sum().get_checksum());
+}
+
+TEST(BiffieldWire, DecodeLittleEndian) {
+  UdpLe::ConstView v(udp_le_bytes);
+  EXPECT_EQ(12345, v.read_ports().get_src());
+  EXPECT_EQ(53, v.read_ports().get_dst());
+  EXPECT_EQ(28, v.read_len_sum().get_length());
+  EXPECT_EQ(0xABCD, v.read_len_sum().get_checksum());
+}
+
+TEST(BiffieldWire, EncodeBigEndian) {
+  uint8_t bytes[UdpBe::size] {};
+  UdpBe::View v(bytes);
+
+  v.write_ports(UdpBe::ports_value_t().with_src(12345).with_dst(53));
+  v.write_len_sum(UdpBe::len_sum_value_t()
+                  .with_length(28)
+                  .with_checksum(0xABCD));
+
+  for (unsigned i = 0; i < sizeof(bytes); ++i) {
+    EXPECT_EQ(udp_be_bytes[i], bytes[i]) << "at byte " << i;
+  }
+}
+
+TEST(BiffieldWire, EncodeLittleEndian) {
+  uint8_t bytes[UdpLe::size] {};
+  UdpLe::View v(bytes);
+
+  v.write_ports(UdpLe::ports_value_t().with_src(12345).with_dst(53));
+  v.write_len_sum(UdpLe::len_sum_value_t()
+                  .with_length(28)
+                  .with_checksum(0xABCD));
+
+  for (unsigned i = 0; i < sizeof(bytes); ++i) {
+    EXPECT_EQ(udp_le_bytes[i], bytes[i]) << "at byte " << i;
+  }
+}
+
+TEST(BiffieldWire, UpdateInPlace) {
+  uint8_t bytes[UdpBe::size];
+  for (unsigned i = 0; i < sizeof(bytes); ++i) bytes[i] = udp_be_bytes[i];
+
+  UdpBe::View v(bytes);
+  v.update_len_sum([] (UdpBe::len_sum_value_t x) {
+      return x.with_checksum(0);
+  });
+
+  EXPECT_EQ(0x00, bytes[6]);
+  EXPECT_EQ(0x00, bytes[7]);
+  EXPECT_EQ(0x1C, bytes[5]) << "Neighboring fields must be preserved.";
+}
+
+TEST(BiffieldWire, ViewOverLargerBuffer) {
+  // Headers are usually parsed in place at the front of a larger packet.
+  uint8_t packet[64] {};
+  for (unsigned i = 0; i < UdpBe::size; ++i) packet[i] = udp_be_bytes[i];
+
+  UdpBe::ConstView v{RangePtr<uint8_t const>(packet)};
+  EXPECT_EQ(53, v.read_ports().get_dst());
+  EXPECT_EQ(RangePtr<uint8_t const>(packet).tail_from(UdpBe::size),
+            v.payload());
+}
+
+TEST(BiffieldWire, ShortBufferAsserts) {
+  uint8_t bytes[UdpBe::size - 1] {};
+  ASSERT_THROW(UdpBe::ConstView{RangePtr<uint8_t const>(bytes)},
+               std::logic_error);
+}
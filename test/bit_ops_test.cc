@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "etl/bits.h"
+
+#include "test/lcg.h"
+
+/*
+ * Tests for the bit-manipulation kernels: counting, rotation, byte swapping
+ * and bit scatter/gather.  The kernels are constexpr and checked statically
+ * where they can be; pdep and pext are also checked at runtime, where they
+ * may use instructions the compiler can't evaluate.
+ */
+
+/*
+ * popcount, countl_zero, countr_zero
+ */
+
+static_assert(etl::popcount(std::uint8_t(0)) == 0, "");
+static_assert(etl::popcount(std::uint8_t(0xFF)) == 8, "");
+static_assert(etl::popcount(std::uint16_t(0x8001)) == 2, "");
+static_assert(etl::popcount(std::uint32_t(0xF0F0F0F0)) == 16, "");
+static_assert(etl::popcount(std::uint64_t(0xFFFFFFFFFFFFFFFF)) == 64, "");
+
+static_assert(etl::countl_zero(std::uint8_t(0)) == 8, "");
+static_assert(etl::countl_zero(std::uint8_t(1)) == 7, "");
+static_assert(etl::countl_zero(std::uint16_t(0x0100)) == 7, "");
+static_assert(etl::countl_zero(std::uint32_t(0x80000000)) == 0, "");
+static_assert(etl::countl_zero(std::uint64_t(0)) == 64, "");
+static_assert(etl::countl_zero(std::uint64_t(1)) == 63, "");
+
+static_assert(etl::countr_zero(std::uint8_t(0)) == 8, "");
+static_assert(etl::countr_zero(std::uint8_t(0x80)) == 7, "");
+static_assert(etl::countr_zero(std::uint32_t(0x00010000)) == 16, "");
+static_assert(etl::countr_zero(std::uint64_t(0)) == 64, "");
+static_assert(etl::countr_zero(std::uint64_t(1) << 63) == 63, "");
+
+
+/*
+ * rotl, rotr
+ */
+
+static_assert(etl::rotl(std::uint8_t(0x81), 1) == 0x03, "");
+static_assert(etl::rotr(std::uint8_t(0x81), 1) == 0xC0, "");
+static_assert(etl::rotl(std::uint32_t(0x12345678), 8) == 0x34567812, "");
+static_assert(etl::rotr(std::uint32_t(0x12345678), 8) == 0x78123456, "");
+static_assert(etl::rotl(std::uint32_t(0x12345678), 0) == 0x12345678,
+              "Rotation by zero must not shift by the full width.");
+static_assert(etl::rotl(std::uint32_t(0x12345678), 32) == 0x12345678,
+              "Rotation counts must be taken modulo the width.");
+static_assert(etl::rotl(std::uint32_t(0x12345678), -8)
+                == etl::rotr(std::uint32_t(0x12345678), 8),
+              "Negative counts rotate the other way.");
+static_assert(etl::rotr(std::uint64_t(1), 1) == std::uint64_t(1) << 63, "");
+
+
+/*
+ * byteswap
+ */
+
+static_assert(etl::byteswap(std::uint8_t(0xAB)) == 0xAB, "");
+static_assert(etl::byteswap(std::uint16_t(0x1234)) == 0x3412, "");
+static_assert(etl::byteswap(std::uint32_t(0x12345678)) == 0x78563412, "");
+static_assert(etl::byteswap(std::uint64_t(0x0102030405060708))
+                == 0x0807060504030201, "");
+
+static_assert(std::is_same<decltype(etl::byteswap(std::uint16_t(0))),
+                           std::uint16_t>::value,
+              "byteswap must preserve its argument type.");
+
+
+/*
+ * pdep, pext
+ *
+ * When BMI2 is available these compile to the instructions, which aren't
+ * constexpr, so the static checks only cover the portable implementation.
+ * Both are also checked at runtime below.
+ */
+
+#ifndef __BMI2__
+  static_assert(etl::pdep(std::uint32_t(0b101), std::uint32_t(0b11100))
+                  == 0b10100, "");
+  static_assert(etl::pext(std::uint32_t(0b10100), std::uint32_t(0b11100))
+                  == 0b101, "");
+  static_assert(etl::pdep(~std::uint64_t(0), std::uint64_t(0)) == 0, "");
+  static_assert(etl::pext(~std::uint64_t(0), std::uint64_t(0)) == 0, "");
+#endif
+
+
+/*******************************************************************************
+ * Dynamic tests - these must be executed.
+ */
+
+/*
+ * Bit-at-a-time reference implementations of pdep and pext.
+ */
+static std::uint64_t slow_pdep(std::uint64_t src, std::uint64_t mask) {
+  std::uint64_t out = 0;
+  for (unsigned i = 0, k = 0; i < 64; ++i) {
+    if (mask & (std::uint64_t(1) << i)) {
+      if (src & (std::uint64_t(1) << k)) out |= std::uint64_t(1) << i;
+      ++k;
+    }
+  }
+  return out;
+}
+
+static std::uint64_t slow_pext(std::uint64_t src, std::uint64_t mask) {
+  std::uint64_t out = 0;
+  for (unsigned i = 0, k = 0; i < 64; ++i) {
+    if (mask & (std::uint64_t(1) << i)) {
+      if (src & (std::uint64_t(1) << i)) out |= std::uint64_t(1) << k;
+      ++k;
+    }
+  }
+  return out;
+}
+
+TEST(Bits, PdepPext) {
+  lcg::Gen64 rng(0x9E3779B97F4A7C15u);
+  for (int i = 0; i < 1000; ++i) {
+    auto src = rng.next();
+    auto mask = rng.next();
+
+    EXPECT_EQ(slow_pdep(src, mask), etl::pdep(src, mask))
+      << std::hex << src << " " << mask;
+    EXPECT_EQ(slow_pext(src, mask), etl::pext(src, mask))
+      << std::hex << src << " " << mask;
+
+    auto src32 = static_cast<std::uint32_t>(src);
+    auto mask32 = static_cast<std::uint32_t>(mask);
+    EXPECT_EQ(slow_pdep(src32, mask32), etl::pdep(src32, mask32));
+    EXPECT_EQ(slow_pext(src32, mask32), etl::pext(src32, mask32));
+  }
+}
+
+TEST(Bits, PdepPextInverse) {
+  auto mask = std::uint64_t(0x00FF00F00F0000F1);
+  for (std::uint64_t x : {std::uint64_t(0), std::uint64_t(0x1234),
+                          ~std::uint64_t(0)}) {
+    auto packed = etl::pext(x, mask);
+    EXPECT_EQ(x & mask, etl::pdep(packed, mask));
+  }
+}
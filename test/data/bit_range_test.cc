@@ -0,0 +1,126 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/bit_range.h"
+#include "etl/data/range_ptr.h"
+
+#include "test/lcg.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for the word-range bit kernels.
+ *
+ * Each kernel is compared against a bit-at-a-time scan, over lengths chosen
+ * to exercise vector remainders, with single bits placed at word and lane
+ * boundaries.
+ */
+
+static constexpr std::size_t max_words = 37;
+static constexpr std::size_t counts[] { 0, 1, 2, 3, 4, 5, 7, 8, 9, 16, 37 };
+
+class BitRangeTest : public ::testing::Test {
+protected:
+  std::uint64_t words[max_words];
+
+  virtual void SetUp() {
+    for (auto & w : words) w = 0;
+  }
+
+  RangePtr<std::uint64_t const> first(std::size_t n) {
+    return RangePtr<std::uint64_t const>(words).first(n);
+  }
+
+  void set(std::size_t bit) {
+    words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+  }
+
+  bool is_set(std::size_t bit) {
+    return (words[bit / 64] >> (bit % 64)) & 1;
+  }
+
+  void fill_noise() {
+    lcg::Gen64 rng;
+    for (auto & w : words) {
+      auto r = rng.next();
+      w = r & (r >> 7);
+    }
+  }
+};
+
+TEST_F(BitRangeTest, PopcountEmpty) {
+  for (auto n : counts) {
+    EXPECT_EQ(0u, popcount(first(n))) << "count " << n;
+  }
+}
+
+TEST_F(BitRangeTest, PopcountFull) {
+  for (auto & w : words) w = ~std::uint64_t(0);
+  for (auto n : counts) {
+    EXPECT_EQ(64 * n, popcount(first(n))) << "count " << n;
+  }
+}
+
+TEST_F(BitRangeTest, PopcountNoise) {
+  fill_noise();
+  for (auto n : counts) {
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < 64 * n; ++i) expected += is_set(i);
+    EXPECT_EQ(expected, popcount(first(n))) << "count " << n;
+  }
+}
+
+TEST_F(BitRangeTest, FindFirstSetEmpty) {
+  for (auto n : counts) {
+    EXPECT_FALSE(!!find_first_set(first(n))) << "count " << n;
+  }
+}
+
+TEST_F(BitRangeTest, FindFirstSetSingleBit) {
+  static constexpr std::size_t bits[] {
+    0, 1, 63, 64, 127, 128, 255, 256, 511, 512, 64 * max_words - 1,
+  };
+  for (auto bit : bits) {
+    SetUp();
+    set(bit);
+    auto found = find_first_set(first(max_words));
+    ASSERT_TRUE(!!found) << "bit " << bit;
+    EXPECT_EQ(bit, found.ref());
+  }
+}
+
+TEST_F(BitRangeTest, FindFirstSetIgnoresPastEnd) {
+  set(64 * 4);
+  EXPECT_FALSE(!!find_first_set(first(4)));
+  EXPECT_TRUE(!!find_first_set(first(5)));
+}
+
+TEST_F(BitRangeTest, FindNextSet) {
+  fill_noise();
+  std::size_t expected = 0;
+  auto r = first(max_words);
+  auto found = find_next_set(r, 0);
+  while (true) {
+    while (expected < 64 * max_words && !is_set(expected)) ++expected;
+    if (expected == 64 * max_words) break;
+
+    ASSERT_TRUE(!!found) << "expected " << expected;
+    ASSERT_EQ(expected, found.ref());
+    ++expected;
+    found = find_next_set(r, found.ref() + 1);
+  }
+  EXPECT_FALSE(!!found);
+}
+
+TEST_F(BitRangeTest, FindNextSetAtEnd) {
+  set(0);
+  EXPECT_FALSE(!!find_next_set(first(1), 64))
+    << "starting at the end must find nothing, not assert";
+}
+
+}  // namespace data
+}  // namespace etl
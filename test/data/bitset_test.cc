@@ -0,0 +1,204 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/bitset.h"
+#include "etl/data/range_ptr.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace data {
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(sizeof(Bitset<1>) == 1, "Small Bitsets should use Uint<8>.");
+static_assert(sizeof(Bitset<8>) == 1, "");
+static_assert(sizeof(Bitset<9>) == 2, "");
+static_assert(sizeof(Bitset<32>) == 4, "");
+static_assert(sizeof(Bitset<33>) == 8, "");
+static_assert(sizeof(Bitset<64>) == 8, "");
+static_assert(sizeof(Bitset<65>) == 16, "Large Bitsets use whole words.");
+static_assert(sizeof(Bitset<1000>) == 16 * 8, "");
+
+static_assert(Bitset<100>::size() == 100, "");
+
+static constexpr Bitset<12> empty_bits{};
+static_assert(!empty_bits.test(0), "");
+static_assert(empty_bits.none(), "");
+
+/*******************************************************************************
+ * Bitset
+ */
+
+template <typename T>
+class BitsetTest : public ::testing::Test {
+protected:
+  using Set = Bitset<T::value>;
+  static constexpr std::size_t n = T::value;
+};
+
+template <typename T>
+constexpr std::size_t BitsetTest<T>::n;
+
+using BitsetSizes = ::testing::Types<
+  std::integral_constant<std::size_t, 1>,
+  std::integral_constant<std::size_t, 8>,
+  std::integral_constant<std::size_t, 31>,
+  std::integral_constant<std::size_t, 64>,
+  std::integral_constant<std::size_t, 65>,
+  std::integral_constant<std::size_t, 300>
+>;
+
+TYPED_TEST_CASE(BitsetTest, BitsetSizes);
+
+TYPED_TEST(BitsetTest, SetResetTest) {
+  typename TestFixture::Set s;
+  auto n = TestFixture::n;
+  EXPECT_TRUE(s.none());
+
+  s.set(0);
+  s.set(n - 1);
+  EXPECT_TRUE(s.test(0));
+  EXPECT_TRUE(s.test(n - 1));
+  EXPECT_TRUE(s.any());
+  EXPECT_EQ(n == 1 ? 1u : 2u, s.count());
+
+  s.reset(0);
+  EXPECT_FALSE(s.test(0));
+  s.flip(0);
+  EXPECT_TRUE(s.test(0));
+}
+
+TYPED_TEST(BitsetTest, SetAllCountsOnlyValidBits) {
+  typename TestFixture::Set s;
+  s.set_all();
+  EXPECT_EQ(TestFixture::n, s.count())
+    << "bits past size() in the last word must stay clear";
+  EXPECT_TRUE(s.all());
+
+  s.flip_all();
+  EXPECT_TRUE(s.none());
+}
+
+TYPED_TEST(BitsetTest, OutOfRangeAsserts) {
+  typename TestFixture::Set s;
+  ASSERT_THROW(s.set(TestFixture::n), std::logic_error);
+  ASSERT_THROW(s.test(TestFixture::n), std::logic_error);
+}
+
+TYPED_TEST(BitsetTest, FindFirst) {
+  typename TestFixture::Set s;
+  EXPECT_FALSE(!!s.find_first());
+
+  s.set(TestFixture::n - 1);
+  ASSERT_TRUE(!!s.find_first());
+  EXPECT_EQ(TestFixture::n - 1, s.find_first().ref());
+}
+
+TEST(Bitset, WordParallelOps) {
+  Bitset<130> a, b;
+  for (std::size_t i = 0; i < 130; i += 2) a.set(i);
+  for (std::size_t i = 0; i < 130; i += 3) b.set(i);
+
+  auto both = a & b;
+  auto either = a | b;
+  auto one = a ^ b;
+  auto only_a = andnot(a, b);
+
+  for (std::size_t i = 0; i < 130; ++i) {
+    bool x = i % 2 == 0, y = i % 3 == 0;
+    EXPECT_EQ(x && y, both.test(i)) << "at " << i;
+    EXPECT_EQ(x || y, either.test(i)) << "at " << i;
+    EXPECT_EQ(x != y, one.test(i)) << "at " << i;
+    EXPECT_EQ(x && !y, only_a.test(i)) << "at " << i;
+  }
+
+  a &= b;
+  EXPECT_EQ(both, a);
+}
+
+/*******************************************************************************
+ * BitVector
+ */
+
+class BitVectorTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t bits = 200;
+
+  std::uint64_t a_words[4], b_words[4];
+  BitVector a{RangePtr<std::uint64_t>(a_words), bits};
+  BitVector b{RangePtr<std::uint64_t>(b_words), bits};
+
+  virtual void SetUp() {
+    a.reset_all();
+    b.reset_all();
+    for (std::size_t i = 0; i < bits; i += 2) a.set(i);
+    for (std::size_t i = 0; i < bits; i += 5) b.set(i);
+  }
+};
+
+constexpr std::size_t BitVectorTest::bits;
+
+TEST_F(BitVectorTest, Basics) {
+  EXPECT_EQ(bits, a.size());
+  EXPECT_EQ(100u, a.count());
+  EXPECT_EQ(40u, b.count());
+  EXPECT_TRUE(a.test(198));
+  EXPECT_FALSE(a.test(199));
+}
+
+TEST_F(BitVectorTest, UsesCallerStorage) {
+  a.reset_all();
+  a.set(65);
+  EXPECT_EQ(0u, a_words[0]);
+  EXPECT_EQ(2u, a_words[1]);
+}
+
+TEST_F(BitVectorTest, SetAllLeavesTailClear) {
+  a.set_all();
+  EXPECT_EQ(bits, a.count());
+  EXPECT_EQ(0u, a_words[3] >> (bits % 64))
+    << "bits past size() must stay clear";
+}
+
+TEST_F(BitVectorTest, StorageTooSmallAsserts) {
+  ASSERT_THROW((BitVector{RangePtr<std::uint64_t>(a_words), 257}),
+               std::logic_error);
+}
+
+TEST_F(BitVectorTest, WordParallelOps) {
+  std::uint64_t c_words[4];
+  BitVector c{RangePtr<std::uint64_t>(c_words), bits};
+
+  c.assign(a);
+  c.and_with(b);
+  EXPECT_EQ(20u, c.count());
+
+  c.assign(a);
+  c.or_with(b);
+  EXPECT_EQ(120u, c.count());
+
+  c.assign(a);
+  c.xor_with(b);
+  EXPECT_EQ(100u, c.count());
+
+  c.assign(a);
+  c.andnot_with(b);
+  EXPECT_EQ(80u, c.count());
+  for (std::size_t i = 0; i < bits; ++i) {
+    EXPECT_EQ(i % 2 == 0 && i % 5 != 0, c.test(i)) << "at " << i;
+  }
+}
+
+TEST_F(BitVectorTest, MismatchedSizesAssert) {
+  std::uint64_t c_words[4];
+  BitVector c{RangePtr<std::uint64_t>(c_words), bits - 1};
+  ASSERT_THROW(c.and_with(a), std::logic_error);
+}
+
+}  // namespace data
+}  // namespace etl
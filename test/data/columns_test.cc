@@ -0,0 +1,237 @@
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/columns.h"
+#include "etl/data/range_ptr.h"
+#include "etl/mem/arena.h"
+#include "etl/type_list.h"
+
+using etl::TypeList;
+using etl::data::Columns;
+using etl::data::RangePtr;
+using etl::mem::Arena;
+
+/*
+ * Component types, of deliberately mixed sizes and alignments, so that the
+ * column layout has to insert padding.
+ */
+struct Position { float x, y; };
+struct Velocity { float dx, dy; };
+struct Flags { std::uint8_t bits; };
+struct Id { std::uint64_t value; };
+
+using World = Columns<TypeList<Position, Flags, Velocity, Id>>;
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(std::is_same<World::Types,
+                           TypeList<Position, Flags, Velocity, Id>>::value,
+              "Columns must expose its component types.");
+
+static_assert(World::bytes_for(0) == 0, "");
+static_assert(World::bytes_for(1)
+                >= sizeof(Position) + sizeof(Flags)
+                   + sizeof(Velocity) + sizeof(Id),
+              "bytes_for must cover one of each component.");
+static_assert(World::bytes_for(16)
+                <= 16 * (sizeof(Position) + sizeof(Flags)
+                         + sizeof(Velocity) + sizeof(Id))
+                   + 4 * etl::MaxAlignOf<World::Types>::value,
+              "bytes_for may pad each column to MaxAlignOf, but no more.");
+
+/*******************************************************************************
+ * Dynamic tests - these must be executed.
+ */
+
+class ColumnsTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t capacity = 13;
+
+  alignas(8) std::uint8_t region[World::bytes_for(capacity) + 64];
+  Arena<> arena{region};
+
+  virtual void SetUp() {
+    arena.reset();
+  }
+
+  bool is_in_region(void const * p) {
+    return p >= &region[0] && p < &region[sizeof(region)];
+  }
+
+  template <typename T>
+  static bool is_aligned(T const * p) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignof(T) == 0;
+  }
+
+  void fill(World & w, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      auto f = static_cast<float>(i);
+      w.append(Position{f, -f},
+               Flags{std::uint8_t(i)},
+               Velocity{1, 2},
+               Id{i * 100});
+    }
+  }
+};
+
+constexpr std::size_t ColumnsTest::capacity;
+
+TEST_F(ColumnsTest, SingleAllocation) {
+  auto free_before = arena.get_free_count();
+  World w(arena, capacity);
+  EXPECT_EQ(World::bytes_for(capacity), free_before - arena.get_free_count())
+    << "all columns must come from a single allocation";
+  EXPECT_EQ(capacity, w.capacity());
+  EXPECT_EQ(0u, w.count());
+}
+
+TEST_F(ColumnsTest, ColumnsAreInRegionAndAligned) {
+  World w(arena, capacity);
+  fill(w, capacity);
+
+  auto p = w.column<Position>();
+  auto f = w.column<Flags>();
+  auto v = w.column<Velocity>();
+  auto id = w.column<Id>();
+
+  EXPECT_TRUE(is_in_region(p.base()));
+  EXPECT_TRUE(is_in_region(f.base()));
+  EXPECT_TRUE(is_in_region(v.base()));
+  EXPECT_TRUE(is_in_region(id.base()));
+
+  EXPECT_TRUE(is_aligned(p.base()));
+  EXPECT_TRUE(is_aligned(v.base()));
+  EXPECT_TRUE(is_aligned(id.base()));
+}
+
+TEST_F(ColumnsTest, ColumnsDoNotOverlap) {
+  World w(arena, capacity);
+  fill(w, capacity);
+
+  auto p = w.column<Position>();
+  auto f = w.column<Flags>();
+  auto v = w.column<Velocity>();
+  auto id = w.column<Id>();
+
+  auto begin = [] (void const * base) {
+    return static_cast<std::uint8_t const *>(base);
+  };
+
+  // Columns are laid out in TypeList order, each ending before the next.
+  EXPECT_LE(begin(p.base()) + p.byte_length(), begin(f.base()));
+  EXPECT_LE(begin(f.base()) + f.byte_length(), begin(v.base()));
+  EXPECT_LE(begin(v.base()) + v.byte_length(), begin(id.base()));
+}
+
+TEST_F(ColumnsTest, ColumnsTrackCount) {
+  World w(arena, capacity);
+  EXPECT_TRUE(w.column<Position>().is_empty());
+
+  fill(w, 5);
+  EXPECT_EQ(5u, w.count());
+  EXPECT_EQ(5u, w.column<Position>().count());
+  EXPECT_EQ(5u, w.column<Id>().count());
+}
+
+TEST_F(ColumnsTest, AppendStoresEachComponent) {
+  World w(arena, capacity);
+  fill(w, capacity);
+
+  for (std::size_t i = 0; i < capacity; ++i) {
+    EXPECT_EQ(static_cast<float>(i), w.column<Position>()[i].x);
+    EXPECT_EQ(std::uint8_t(i), w.column<Flags>()[i].bits);
+    EXPECT_EQ(2.f, w.column<Velocity>()[i].dy);
+    EXPECT_EQ(i * 100, w.column<Id>()[i].value);
+  }
+}
+
+TEST_F(ColumnsTest, AppendReturnsIndex) {
+  World w(arena, capacity);
+  EXPECT_EQ(0u, w.append(Position{}, Flags{}, Velocity{}, Id{}));
+  EXPECT_EQ(1u, w.append(Position{}, Flags{}, Velocity{}, Id{}));
+}
+
+TEST_F(ColumnsTest, AppendPastCapacityAsserts) {
+  World w(arena, capacity);
+  fill(w, capacity);
+  ASSERT_THROW(w.append(Position{}, Flags{}, Velocity{}, Id{}),
+               std::logic_error);
+}
+
+TEST_F(ColumnsTest, ArenaTooSmallAsserts) {
+  std::uint8_t small[16];
+  Arena<> small_arena(small);
+  // A new arena is exhausted until reset; without this, the allocation
+  // would fail whatever the arena's size.
+  small_arena.reset();
+  ASSERT_THROW((World{small_arena, capacity}), std::logic_error);
+}
+
+TEST_F(ColumnsTest, SwapRemove) {
+  World w(arena, capacity);
+  fill(w, 4);
+
+  // Removing entity 1 moves the last entity (3) into its place.
+  w.swap_remove(1);
+  EXPECT_EQ(3u, w.count());
+  EXPECT_EQ(300u, w.column<Id>()[1].value);
+  EXPECT_EQ(3.f, w.column<Position>()[1].x);
+  EXPECT_EQ(std::uint8_t(3), w.column<Flags>()[1].bits);
+
+  ASSERT_THROW(w.swap_remove(3), std::logic_error);
+}
+
+TEST_F(ColumnsTest, Clear) {
+  World w(arena, capacity);
+  fill(w, capacity);
+  w.clear();
+  EXPECT_EQ(0u, w.count());
+  EXPECT_EQ(capacity, w.capacity());
+  fill(w, 2);
+  EXPECT_EQ(2u, w.count());
+}
+
+/*
+ * Integrates velocity into position, which touches only two of the four
+ * columns.
+ */
+struct Integrate {
+  float dt;
+
+  void operator()(Position & p, Velocity const & v) const {
+    p.x += v.dx * dt;
+    p.y += v.dy * dt;
+  }
+};
+
+TEST_F(ColumnsTest, ForEachVisitsChosenColumns) {
+  World w(arena, capacity);
+  fill(w, capacity);
+
+  w.for_each<Position, Velocity>(Integrate{0.5f});
+
+  for (std::size_t i = 0; i < capacity; ++i) {
+    auto f = static_cast<float>(i);
+    EXPECT_EQ(f + 0.5f, w.column<Position>()[i].x) << "at " << i;
+    EXPECT_EQ(-f + 1.f, w.column<Position>()[i].y) << "at " << i;
+  }
+}
+
+TEST_F(ColumnsTest, ForEachOverConst) {
+  World w(arena, capacity);
+  fill(w, capacity);
+
+  World const & cw = w;
+  std::uint64_t sum = 0;
+  cw.for_each<Id>([&sum] (Id const & id) { sum += id.value; });
+  EXPECT_EQ(100u * (capacity * (capacity - 1) / 2), sum);
+
+  static_assert(std::is_same<decltype(cw.column<Id>()),
+                             RangePtr<Id const>>::value,
+                "const Columns must yield const columns.");
+}
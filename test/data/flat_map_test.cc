@@ -0,0 +1,239 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/crc32.h"
+#include "etl/data/flat_map.h"
+#include "etl/data/range_ptr.h"
+#include "etl/mem/arena.h"
+
+using etl::mem::Arena;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for FlatMap and FlatSet.
+ *
+ * Most tests run against a deliberately weak hash, so that probe sequences
+ * are long, groups fill up, and deletion has to leave tombstones.
+ */
+
+/*
+ * A hash that sends every key to one of four places.
+ */
+struct CollidingHash {
+  std::uint32_t operator()(std::uint32_t key) const {
+    return key & 3;
+  }
+};
+
+/*
+ * A fixed-size byte key, hashed with CRC32.
+ */
+struct Name {
+  char bytes[12];
+
+  static Name of(char const * s) {
+    Name n;
+    std::memset(n.bytes, 0, sizeof(n.bytes));
+    for (std::size_t i = 0; i < sizeof(n.bytes) && s[i]; ++i) {
+      n.bytes[i] = s[i];
+    }
+    return n;
+  }
+
+  bool operator==(Name const & other) const {
+    return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+  }
+};
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+using IntMap = FlatMap<std::uint32_t, int>;
+
+static_assert(IntMap::bytes_for(0) == 0, "");
+static_assert(IntMap::bytes_for(64)
+                >= 64 * sizeof(IntMap::Slot) + 64,
+              "Storage must cover a slot and a control byte per entry.");
+static_assert(IntMap::max_load_for(64) < 64,
+              "Maps must keep some slots empty so probes terminate.");
+
+/*******************************************************************************
+ * FlatMap
+ */
+
+class FlatMapTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t slots = 64;
+
+  using Map = FlatMap<std::uint32_t, int, CollidingHash>;
+
+  // The most keys the map will take, whatever its maximum load factor.
+  static constexpr std::uint32_t full =
+      static_cast<std::uint32_t>(Map::max_load_for(slots));
+
+  alignas(16) std::uint8_t region[Map::bytes_for(slots)];
+  Map map{RangePtr<std::uint8_t>(region), slots};
+};
+
+constexpr std::size_t FlatMapTest::slots;
+constexpr std::uint32_t FlatMapTest::full;
+
+TEST_F(FlatMapTest, StartsEmpty) {
+  EXPECT_EQ(0u, map.count());
+  EXPECT_EQ(Map::max_load_for(slots), map.capacity());
+  EXPECT_TRUE(map.find(1) == nullptr);
+  EXPECT_FALSE(!!map.get(1));
+}
+
+TEST_F(FlatMapTest, InsertAndFind) {
+  for (std::uint32_t k = 0; k < full; ++k) {
+    EXPECT_TRUE(map.insert(k, int(k) * 10)) << "key " << k;
+  }
+  EXPECT_EQ(full, map.count());
+
+  for (std::uint32_t k = 0; k < full; ++k) {
+    auto p = map.find(k);
+    ASSERT_NE(nullptr, p) << "key " << k;
+    EXPECT_EQ(int(k) * 10, *p);
+    EXPECT_EQ(int(k) * 10, map.get(k).ref());
+  }
+  EXPECT_TRUE(map.find(1000) == nullptr);
+}
+
+TEST_F(FlatMapTest, InsertExistingKeepsValue) {
+  EXPECT_TRUE(map.insert(7, 1));
+  EXPECT_FALSE(map.insert(7, 2));
+  EXPECT_EQ(1, *map.find(7));
+  EXPECT_EQ(1u, map.count());
+}
+
+TEST_F(FlatMapTest, InsertOrAssign) {
+  map.insert_or_assign(7, 1);
+  map.insert_or_assign(7, 2);
+  EXPECT_EQ(2, *map.find(7));
+  EXPECT_EQ(1u, map.count());
+}
+
+TEST_F(FlatMapTest, FindIsMutable) {
+  map.insert(3, 30);
+  *map.find(3) += 1;
+  EXPECT_EQ(31, map.get(3).ref());
+}
+
+TEST_F(FlatMapTest, Erase) {
+  for (std::uint32_t k = 0; k < full; ++k) map.insert(k, int(k));
+
+  // Erase every other key.  The survivors share probe sequences with the
+  // erased keys, so they're only found if erase leaves tombstones.
+  for (std::uint32_t k = 0; k < full; k += 2) EXPECT_TRUE(map.erase(k));
+  EXPECT_FALSE(map.erase(0)) << "erasing a missing key must fail";
+  EXPECT_EQ(full / 2, map.count());
+
+  for (std::uint32_t k = 0; k < full; ++k) {
+    EXPECT_EQ(k % 2 == 1, map.find(k) != nullptr) << "key " << k;
+  }
+}
+
+TEST_F(FlatMapTest, ChurnReusesTombstones) {
+  // Many more insert/erase cycles than there are slots; this would fill the
+  // table with tombstones if they were never reclaimed.
+  for (std::uint32_t k = 0; k < 10000; ++k) {
+    ASSERT_TRUE(map.insert(k, int(k))) << "key " << k;
+    if (k >= 10) ASSERT_TRUE(map.erase(k - 10)) << "key " << k - 10;
+  }
+  EXPECT_EQ(10u, map.count());
+  for (std::uint32_t k = 9990; k < 10000; ++k) {
+    EXPECT_EQ(int(k), map.get(k).ref());
+  }
+}
+
+TEST_F(FlatMapTest, OverfillAsserts) {
+  for (std::uint32_t k = 0; k < map.capacity(); ++k) map.insert(k, 0);
+  ASSERT_THROW(map.insert(1000, 0), std::logic_error);
+}
+
+TEST_F(FlatMapTest, Clear) {
+  for (std::uint32_t k = 0; k < 20; ++k) map.insert(k, 0);
+  map.clear();
+  EXPECT_EQ(0u, map.count());
+  EXPECT_TRUE(map.find(5) == nullptr);
+}
+
+TEST_F(FlatMapTest, ForEach) {
+  for (std::uint32_t k = 0; k < 20; ++k) map.insert(k, int(k));
+  int sum = 0;
+  std::size_t n = 0;
+  map.for_each([&] (std::uint32_t const & k, int & v) {
+    EXPECT_EQ(int(k), v);
+    sum += v;
+    ++n;
+  });
+  EXPECT_EQ(20u, n);
+  EXPECT_EQ(190, sum);
+}
+
+TEST(FlatMap, SlotCountMustBePowerOfTwo) {
+  alignas(16) std::uint8_t region[IntMap::bytes_for(64)];
+  ASSERT_THROW((IntMap{RangePtr<std::uint8_t>(region), 48}),
+               std::logic_error);
+}
+
+TEST(FlatMap, FromArena) {
+  alignas(16) std::uint8_t region[IntMap::bytes_for(128) + 64];
+  Arena<> arena(region);
+  arena.reset();
+
+  auto free_before = arena.get_free_count();
+  IntMap map(arena, 128);
+  EXPECT_EQ(IntMap::bytes_for(128), free_before - arena.get_free_count())
+    << "a map must take one contiguous allocation";
+
+  for (std::uint32_t k = 0; k < 100; ++k) map.insert(k * 7919, int(k));
+  for (std::uint32_t k = 0; k < 100; ++k) {
+    EXPECT_EQ(int(k), map.get(k * 7919).ref());
+  }
+}
+
+TEST(FlatMap, Crc32KeyedByBytes) {
+  using NameMap = FlatMap<Name, int, Crc32Hash<Name>>;
+  alignas(16) std::uint8_t region[NameMap::bytes_for(16)];
+  NameMap map{RangePtr<std::uint8_t>(region), 16};
+
+  EXPECT_TRUE(map.insert(Name::of("alpha"), 1));
+  EXPECT_TRUE(map.insert(Name::of("beta"), 2));
+  EXPECT_TRUE(map.insert(Name::of("gamma"), 3));
+
+  EXPECT_EQ(2, map.get(Name::of("beta")).ref());
+  EXPECT_FALSE(!!map.get(Name::of("delta")));
+}
+
+/*******************************************************************************
+ * FlatSet
+ */
+
+TEST(FlatSet, Basics) {
+  using Set = FlatSet<std::uint32_t, CollidingHash>;
+  alignas(16) std::uint8_t region[Set::bytes_for(32)];
+  Set set{RangePtr<std::uint8_t>(region), 32};
+
+  EXPECT_TRUE(set.insert(5));
+  EXPECT_FALSE(set.insert(5));
+  EXPECT_TRUE(set.insert(9));
+  EXPECT_TRUE(set.contains(5));
+  EXPECT_TRUE(set.contains(9));
+  EXPECT_FALSE(set.contains(13));
+  EXPECT_EQ(2u, set.count());
+
+  EXPECT_TRUE(set.erase(5));
+  EXPECT_FALSE(set.contains(5));
+  EXPECT_TRUE(set.contains(9));
+}
+
+}  // namespace data
+}  // namespace etl
@@ -0,0 +1,191 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/intrusive_heap.h"
+#include "etl/data/range_ptr.h"
+#include "etl/non_null.h"
+
+#include "test/lcg.h"
+
+using etl::NonNull;
+using etl::null_check;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for the intrusive priority queues.
+ *
+ * Both heaps are driven through the same random sequence of pushes, pops,
+ * removals and key changes, and checked against a brute-force scan over the
+ * live entries.
+ */
+
+struct Job {
+  std::uint32_t deadline;
+  bool queued = false;
+  PairingLink pairing_link;
+  HeapIndex heap_index;
+};
+
+/*
+ * Orders jobs by deadline, earliest first.
+ */
+struct EarlierDeadline {
+  bool operator()(Job const & a, Job const & b) const {
+    return a.deadline < b.deadline;
+  }
+};
+
+using Pairing = PairingHeap<Job, &Job::pairing_link, EarlierDeadline>;
+using Quad = DaryHeap<Job, &Job::heap_index, 4, EarlierDeadline>;
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(sizeof(HeapIndex) <= sizeof(std::size_t), "");
+static_assert(Quad::arity() == 4, "");
+
+/*******************************************************************************
+ * Shared random workload.
+ */
+
+static constexpr std::size_t job_count = 500;
+
+/*
+ * Adapts the two heaps to one interface, since the d-ary heap needs caller
+ * storage for its array of pointers.
+ */
+struct PairingFixture {
+  Pairing heap;
+};
+
+struct QuadFixture {
+  Job * slots[job_count];
+  Quad heap{RangePtr<Job *>(slots)};
+};
+
+template <typename Fixture>
+class HeapTest : public ::testing::Test {
+protected:
+  Job jobs[job_count];
+  // After jobs, so that it is destroyed first.
+  Fixture f;
+  lcg::Gen32 rng{7};
+
+  // A test that fails an ASSERT returns with jobs still queued; take them
+  // out before the heap goes away.
+  virtual void TearDown() {
+    while (!f.heap.is_empty()) f.heap.pop()->queued = false;
+  }
+
+  std::uint32_t next() {
+    return rng.next();
+  }
+
+  // The live job with the earliest deadline, by brute force.  Ties are
+  // broken arbitrarily by the heaps, so only the deadline is compared.
+  std::uint32_t expected_min() {
+    std::uint32_t best = ~std::uint32_t(0);
+    for (auto & j : jobs) {
+      if (j.queued && j.deadline < best) best = j.deadline;
+    }
+    return best;
+  }
+
+  NonNull<Job *> job(std::size_t i) {
+    return null_check(&jobs[i]);
+  }
+};
+
+using HeapTypes = ::testing::Types<PairingFixture, QuadFixture>;
+TYPED_TEST_CASE(HeapTest, HeapTypes);
+
+TYPED_TEST(HeapTest, StartsEmpty) {
+  EXPECT_TRUE(this->f.heap.is_empty());
+  EXPECT_EQ(0u, this->f.heap.count());
+  ASSERT_THROW(this->f.heap.top(), std::logic_error);
+  ASSERT_THROW(this->f.heap.pop(), std::logic_error);
+}
+
+TYPED_TEST(HeapTest, HeapSort) {
+  for (std::size_t i = 0; i < job_count; ++i) {
+    this->jobs[i].deadline = this->next() % 1000;
+    this->f.heap.push(this->job(i));
+  }
+  EXPECT_EQ(job_count, this->f.heap.count());
+
+  std::uint32_t last = 0;
+  for (std::size_t i = 0; i < job_count; ++i) {
+    auto j = this->f.heap.pop();
+    ASSERT_LE(last, j->deadline) << "pop " << i;
+    last = j->deadline;
+  }
+  EXPECT_TRUE(this->f.heap.is_empty());
+}
+
+TYPED_TEST(HeapTest, RandomOperations) {
+  for (int step = 0; step < 20000; ++step) {
+    auto i = this->next() % job_count;
+    auto & j = this->jobs[i];
+
+    if (!j.queued) {
+      j.deadline = this->next() % 10000;
+      this->f.heap.push(this->job(i));
+      j.queued = true;
+    } else {
+      switch (this->next() % 4) {
+        case 0:
+          this->f.heap.remove(this->job(i));
+          j.queued = false;
+          break;
+
+        case 1:
+          j.deadline -= j.deadline / 2;
+          this->f.heap.decrease_key(this->job(i));
+          break;
+
+        case 2:
+          j.deadline += this->next() % 100;
+          this->f.heap.update(this->job(i));
+          break;
+
+        default: {
+          auto top = this->f.heap.pop();
+          ASSERT_EQ(this->expected_min(), top->deadline) << "step " << step;
+          top->queued = false;
+          break;
+        }
+      }
+    }
+
+    if (!this->f.heap.is_empty()) {
+      ASSERT_EQ(this->expected_min(), this->f.heap.top()->deadline)
+        << "step " << step;
+    }
+  }
+}
+
+TYPED_TEST(HeapTest, DoublePushAsserts) {
+  this->jobs[0].deadline = 1;
+  this->f.heap.push(this->job(0));
+  ASSERT_THROW(this->f.heap.push(this->job(0)), std::logic_error);
+}
+
+TEST(DaryHeap, FullAsserts) {
+  Job jobs[3] {};
+  Job * slots[2];
+  Quad heap{RangePtr<Job *>(slots)};
+  heap.push(null_check(&jobs[0]));
+  heap.push(null_check(&jobs[1]));
+  // EXPECT, so that the pops below run even if this fails.
+  EXPECT_THROW(heap.push(null_check(&jobs[2])), std::logic_error);
+  heap.pop();
+  heap.pop();
+}
+
+}  // namespace data
+}  // namespace etl
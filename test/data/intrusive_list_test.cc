@@ -0,0 +1,188 @@
+#include <initializer_list>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/intrusive_list.h"
+#include "etl/non_null.h"
+
+using etl::NonNull;
+using etl::null_check;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for IntrusiveList and IntrusiveStack.
+ */
+
+/*
+ * A user type carrying links for both containers, so that one object can be
+ * on a list and a stack at once.
+ */
+struct Task {
+  int id;
+  ListLink run_link;
+  StackLink free_link;
+
+  explicit Task(int i = 0) : id(i) {}
+};
+
+using RunList = IntrusiveList<Task, &Task::run_link>;
+using FreeStack = IntrusiveStack<Task, &Task::free_link>;
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(sizeof(ListLink) == 2 * sizeof(void *),
+              "A list link is two pointers.");
+static_assert(sizeof(StackLink) == sizeof(void *),
+              "A stack link is one pointer.");
+
+/*******************************************************************************
+ * IntrusiveList
+ */
+
+class IntrusiveListTest : public ::testing::Test {
+protected:
+  // Declared before the tasks so that it's destroyed after them: tasks left
+  // on the list unlink themselves as they die, which needs the list alive.
+  RunList list;
+  Task tasks[5];
+
+  IntrusiveListTest() {
+    for (int i = 0; i < 5; ++i) tasks[i].id = i;
+  }
+
+  NonNull<Task *> task(int i) {
+    return null_check(&tasks[i]);
+  }
+
+  void expect_ids(std::initializer_list<int> ids) {
+    auto it = ids.begin();
+    for (auto & t : list) {
+      ASSERT_NE(ids.end(), it) << "list longer than expected";
+      EXPECT_EQ(*it, t.id);
+      ++it;
+    }
+    EXPECT_EQ(ids.end(), it) << "list shorter than expected";
+    EXPECT_EQ(ids.size(), list.count());
+  }
+};
+
+TEST_F(IntrusiveListTest, StartsEmpty) {
+  EXPECT_TRUE(list.is_empty());
+  EXPECT_EQ(0u, list.count());
+  EXPECT_FALSE(tasks[0].run_link.is_linked());
+}
+
+TEST_F(IntrusiveListTest, PushBackAndFront) {
+  list.push_back(task(1));
+  list.push_back(task(2));
+  list.push_front(task(0));
+  expect_ids({0, 1, 2});
+
+  EXPECT_EQ(&tasks[0], list.front().get());
+  EXPECT_EQ(&tasks[2], list.back().get());
+  EXPECT_TRUE(tasks[1].run_link.is_linked());
+}
+
+TEST_F(IntrusiveListTest, PopFrontAndBack) {
+  for (int i = 0; i < 4; ++i) list.push_back(task(i));
+
+  EXPECT_EQ(&tasks[0], list.pop_front().get());
+  EXPECT_EQ(&tasks[3], list.pop_back().get());
+  expect_ids({1, 2});
+  EXPECT_FALSE(tasks[0].run_link.is_linked())
+    << "popping must unlink the node";
+}
+
+TEST_F(IntrusiveListTest, EmptyAccessAsserts) {
+  ASSERT_THROW(list.front(), std::logic_error);
+  ASSERT_THROW(list.pop_front(), std::logic_error);
+  ASSERT_THROW(list.pop_back(), std::logic_error);
+}
+
+TEST_F(IntrusiveListTest, RemoveFromMiddle) {
+  for (int i = 0; i < 5; ++i) list.push_back(task(i));
+  list.remove(task(2));
+  expect_ids({0, 1, 3, 4});
+  list.remove(task(0));
+  list.remove(task(4));
+  expect_ids({1, 3});
+}
+
+TEST_F(IntrusiveListTest, DoubleInsertAsserts) {
+  list.push_back(task(0));
+  ASSERT_THROW(list.push_back(task(0)), std::logic_error);
+}
+
+TEST_F(IntrusiveListTest, RemoveUnlinkedAsserts) {
+  ASSERT_THROW(list.remove(task(0)), std::logic_error);
+}
+
+TEST_F(IntrusiveListTest, InsertBefore) {
+  list.push_back(task(0));
+  list.push_back(task(2));
+  list.insert_before(task(2), task(1));
+  expect_ids({0, 1, 2});
+}
+
+TEST_F(IntrusiveListTest, Splice) {
+  RunList other;
+  list.push_back(task(0));
+  list.push_back(task(1));
+  other.push_back(task(2));
+  other.push_back(task(3));
+
+  list.splice_back(other);
+  expect_ids({0, 1, 2, 3});
+  EXPECT_TRUE(other.is_empty());
+}
+
+TEST_F(IntrusiveListTest, UnlinkOnDestruction) {
+  list.push_back(task(0));
+  {
+    Task temp{9};
+    list.push_back(null_check(&temp));
+    list.push_back(task(1));
+  }
+  // The link's destructor must have removed temp from the list.
+  expect_ids({0, 1});
+}
+
+/*******************************************************************************
+ * IntrusiveStack
+ */
+
+TEST_F(IntrusiveListTest, StackIsLifo) {
+  FreeStack stack;
+  EXPECT_TRUE(stack.is_empty());
+
+  for (int i = 0; i < 3; ++i) stack.push(task(i));
+  EXPECT_EQ(&tasks[2], stack.top().get());
+  EXPECT_EQ(&tasks[2], stack.pop().get());
+  EXPECT_EQ(&tasks[1], stack.pop().get());
+  EXPECT_EQ(&tasks[0], stack.pop().get());
+  EXPECT_TRUE(stack.is_empty());
+  ASSERT_THROW(stack.pop(), std::logic_error);
+}
+
+TEST_F(IntrusiveListTest, ListAndStackAtOnce) {
+  FreeStack stack;
+  for (int i = 0; i < 3; ++i) {
+    list.push_back(task(i));
+    stack.push(task(i));
+  }
+  list.remove(task(1));
+  EXPECT_EQ(&tasks[2], stack.pop().get())
+    << "the two links must be independent";
+  expect_ids({0, 2});
+
+  // The stack dies before the fixture's tasks; don't leave them on it.
+  while (!stack.is_empty()) stack.pop();
+}
+
+}  // namespace data
+}  // namespace etl
@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/bitset.h"
+#include "etl/data/range_ptr.h"
+#include "etl/data/rank_select.h"
+
+#include "test/lcg.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for the RankSelect index.
+ *
+ * Answers are compared against a linear scan, over densities from empty to
+ * full, at lengths that end partway through a word and through an index
+ * block.
+ */
+
+static constexpr std::size_t max_bits = 5000;
+static constexpr std::size_t max_words = (max_bits + 63) / 64;
+
+static_assert(RankSelect::index_count_for(max_bits) * 64 * 4
+                <= max_bits + 64 * 4,
+              "The index should cost at most a quarter of the bits.");
+
+class RankSelectTest : public ::testing::Test {
+protected:
+  std::uint64_t words[max_words];
+  std::uint64_t index[RankSelect::index_count_for(max_bits)];
+
+  // Fills the first n bits so that roughly one in 'one_in' is set.
+  void fill(std::size_t n, unsigned one_in) {
+    lcg::Gen64 rng(12345);
+    BitVector v{RangePtr<std::uint64_t>(words), n};
+    v.reset_all();
+    for (std::size_t i = 0; i < n; ++i) {
+      auto r = rng.next();
+      if (one_in && (r >> 33) % one_in == 0) v.set(i);
+    }
+  }
+
+  RankSelect build(std::size_t n) {
+    return RankSelect{
+      RangePtr<std::uint64_t const>(words).first((n + 63) / 64),
+      n,
+      RangePtr<std::uint64_t>(index).first(RankSelect::index_count_for(n)),
+    };
+  }
+
+  bool is_set(std::size_t i) {
+    return (words[i / 64] >> (i % 64)) & 1;
+  }
+
+  void check(std::size_t n) {
+    auto rs = build(n);
+    std::size_t ones = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(ones, rs.rank1(i)) << "n " << n << " at " << i;
+      ASSERT_EQ(i - ones, rs.rank0(i)) << "n " << n << " at " << i;
+      if (is_set(i)) {
+        auto found = rs.select1(ones);
+        ASSERT_TRUE(!!found) << "n " << n << " one " << ones;
+        ASSERT_EQ(i, found.ref()) << "n " << n << " one " << ones;
+        ++ones;
+      }
+    }
+    EXPECT_EQ(ones, rs.rank1(n));
+    EXPECT_EQ(ones, rs.count_ones());
+    EXPECT_FALSE(!!rs.select1(ones)) << "select past the last one";
+  }
+};
+
+TEST_F(RankSelectTest, Empty) {
+  fill(max_bits, 0);
+  check(max_bits);
+}
+
+TEST_F(RankSelectTest, Full) {
+  fill(max_bits, 1);
+  check(max_bits);
+}
+
+TEST_F(RankSelectTest, Densities) {
+  for (unsigned one_in : {2u, 3u, 10u, 100u, 1000u}) {
+    fill(max_bits, one_in);
+    check(max_bits);
+  }
+}
+
+TEST_F(RankSelectTest, OddLengths) {
+  for (std::size_t n : {1u, 63u, 64u, 65u, 511u, 512u, 513u, 4097u}) {
+    fill(n, 3);
+    check(n);
+  }
+}
+
+TEST_F(RankSelectTest, Select0) {
+  fill(1000, 4);
+  auto rs = build(1000);
+  std::size_t zeros = 0;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    if (!is_set(i)) {
+      auto found = rs.select0(zeros);
+      ASSERT_TRUE(!!found);
+      ASSERT_EQ(i, found.ref());
+      ++zeros;
+    }
+  }
+  EXPECT_FALSE(!!rs.select0(zeros));
+}
+
+TEST_F(RankSelectTest, RankPastEndAsserts) {
+  fill(100, 2);
+  auto rs = build(100);
+  ASSERT_THROW(rs.rank1(101), std::logic_error);
+}
+
+TEST_F(RankSelectTest, IndexTooSmallAsserts) {
+  fill(max_bits, 2);
+  ASSERT_THROW((RankSelect{
+                  RangePtr<std::uint64_t const>(words),
+                  max_bits,
+                  RangePtr<std::uint64_t>(index).first(1),
+                }),
+               std::logic_error);
+}
+
+}  // namespace data
+}  // namespace etl
@@ -0,0 +1,277 @@
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/data/ring.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for the lock-free ring buffers.
+ *
+ * The single-threaded tests pin down the queue semantics; the stress tests
+ * then run real producer and consumer threads against small rings, so that
+ * the indices wrap many times and the full and empty cases are hit often.
+ *
+ * The rings are over-aligned, so every test keeps its ring on the stack
+ * rather than in a fixture: gtest allocates fixtures with new, which doesn't
+ * honor extended alignment before C++17.
+ */
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(alignof(SpscRing<int, 8>) >= cache_line_bytes,
+              "Ring indices must sit on their own cache lines.");
+static_assert(sizeof(SpscRing<int, 8>) >= 2 * cache_line_bytes,
+              "Producer and consumer indices must not share a line.");
+static_assert(alignof(MpmcRing<int>) >= cache_line_bytes, "");
+
+/*******************************************************************************
+ * SpscRing, single-threaded.
+ */
+
+using Spsc = SpscRing<int, 8>;
+
+TEST(SpscRing, StartsEmpty) {
+  int storage[8];
+  Spsc ring{RangePtr<int>(storage)};
+
+  EXPECT_EQ(8u, ring.capacity());
+  EXPECT_TRUE(ring.is_empty());
+  EXPECT_FALSE(!!ring.try_pop());
+}
+
+TEST(SpscRing, Fifo) {
+  int storage[8];
+  Spsc ring{RangePtr<int>(storage)};
+
+  for (int i = 0; i < 8; ++i) EXPECT_TRUE(ring.try_push(i));
+  EXPECT_FALSE(ring.try_push(8)) << "push to a full ring must fail";
+
+  for (int i = 0; i < 8; ++i) {
+    auto m = ring.try_pop();
+    ASSERT_TRUE(!!m);
+    EXPECT_EQ(i, m.ref());
+  }
+  EXPECT_FALSE(!!ring.try_pop());
+}
+
+TEST(SpscRing, Wraps) {
+  int storage[8];
+  Spsc ring{RangePtr<int>(storage)};
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(ring.try_push(i));
+    ASSERT_TRUE(ring.try_push(-i));
+    EXPECT_EQ(i, ring.try_pop().ref());
+    EXPECT_EQ(-i, ring.try_pop().ref());
+  }
+}
+
+TEST(SpscRing, PushNPopN) {
+  int storage[8];
+  Spsc ring{RangePtr<int>(storage)};
+
+  int in[12], out[12];
+  for (int i = 0; i < 12; ++i) in[i] = i * 10;
+
+  EXPECT_EQ(8u, ring.push_n(RangePtr<int const>(in)))
+    << "push_n must stop when the ring fills";
+  EXPECT_EQ(5u, ring.pop_n(RangePtr<int>(out).first(5)));
+  EXPECT_EQ(5u, ring.push_n(RangePtr<int const>(in).tail_from(8)))
+    << "push_n must stop when the input runs out";
+  EXPECT_EQ(8u, ring.pop_n(RangePtr<int>(out).tail_from(5).first(8)))
+    << "pop_n must stop when the ring empties";
+
+  int expected[] { 0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110 };
+  for (int i = 0; i < 12; ++i) EXPECT_EQ(expected[i], out[i]) << "at " << i;
+}
+
+TEST(SpscRing, WrongStorageSizeAsserts) {
+  int storage[7];
+  ASSERT_THROW(Spsc{RangePtr<int>(storage)}, std::logic_error);
+}
+
+/*******************************************************************************
+ * MpmcRing, single-threaded.
+ */
+
+TEST(MpmcRing, Fifo) {
+  MpmcRing<int>::Cell cells[8];
+  MpmcRing<int> ring{RangePtr<MpmcRing<int>::Cell>(cells)};
+
+  EXPECT_EQ(8u, ring.capacity());
+  for (int i = 0; i < 8; ++i) EXPECT_TRUE(ring.try_push(i));
+  EXPECT_FALSE(ring.try_push(8));
+
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(i, ring.try_pop().ref());
+  EXPECT_FALSE(!!ring.try_pop());
+}
+
+TEST(MpmcRing, PushNPopN) {
+  MpmcRing<int>::Cell cells[8];
+  MpmcRing<int> ring{RangePtr<MpmcRing<int>::Cell>(cells)};
+
+  int in[5] { 1, 2, 3, 4, 5 }, out[5] {};
+  EXPECT_EQ(5u, ring.push_n(RangePtr<int const>(in)));
+  EXPECT_EQ(5u, ring.pop_n(RangePtr<int>(out)));
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(in[i], out[i]);
+}
+
+TEST(MpmcRing, NonPowerOfTwoAsserts) {
+  MpmcRing<int>::Cell cells[6];
+  ASSERT_THROW(MpmcRing<int>{RangePtr<MpmcRing<int>::Cell>(cells)},
+               std::logic_error);
+}
+
+/*******************************************************************************
+ * Stress tests.
+ */
+
+static constexpr std::uint32_t items_per_producer = 200000;
+
+/*
+ * A failed ASSERT would return with the producer thread still joinable, which
+ * terminates the process.  So the consumers below EXPECT, stop the producer
+ * and join it, and only then assert.
+ */
+
+TEST(SpscRingStress, OrderAndCompleteness) {
+  std::uint32_t storage[16];
+  SpscRing<std::uint32_t, 16> ring{RangePtr<std::uint32_t>(storage)};
+  std::atomic<bool> stop{false};
+
+  std::thread producer([&ring, &stop] {
+    for (std::uint32_t i = 0; i < items_per_producer && !stop.load(); ) {
+      if (ring.try_push(i)) ++i;
+    }
+  });
+
+  std::uint32_t expected = 0;
+  while (expected < items_per_producer) {
+    auto m = ring.try_pop();
+    if (!m) continue;
+    if (m.ref() != expected) {
+      EXPECT_EQ(expected, m.ref());
+      break;
+    }
+    ++expected;
+  }
+
+  stop = true;
+  producer.join();
+  ASSERT_EQ(items_per_producer, expected);
+  EXPECT_TRUE(ring.is_empty());
+}
+
+TEST(SpscRingStress, Batched) {
+  std::uint32_t storage[64];
+  SpscRing<std::uint32_t, 64> ring{RangePtr<std::uint32_t>(storage)};
+
+  std::atomic<bool> stop{false};
+
+  std::thread producer([&ring, &stop] {
+    std::uint32_t batch[7];
+    for (std::uint32_t next = 0; next < items_per_producer && !stop.load(); ) {
+      std::size_t n = 0;
+      while (n < 7 && next + n < items_per_producer) {
+        batch[n] = next + std::uint32_t(n);
+        ++n;
+      }
+      next += std::uint32_t(
+          ring.push_n(RangePtr<std::uint32_t const>(batch).first(n)));
+    }
+  });
+
+  std::uint32_t batch[5];
+  std::uint32_t expected = 0;
+  bool in_order = true;
+  while (in_order && expected < items_per_producer) {
+    auto n = ring.pop_n(RangePtr<std::uint32_t>(batch));
+    for (std::size_t i = 0; i < n; ++i) {
+      if (batch[i] != expected) {
+        EXPECT_EQ(expected, batch[i]);
+        in_order = false;
+        break;
+      }
+      ++expected;
+    }
+  }
+
+  stop = true;
+  producer.join();
+  ASSERT_EQ(items_per_producer, expected);
+}
+
+/*
+ * Each producer tags its values with its index in the top byte.  Consumers
+ * check that each producer's values arrive in order (per consumer), and the
+ * union of everything consumed is checked for exactly-once delivery.
+ */
+TEST(MpmcRingStress, ExactlyOnce) {
+  static constexpr unsigned producers = 4, consumers = 4;
+
+  MpmcRing<std::uint32_t>::Cell cells[32];
+  MpmcRing<std::uint32_t> ring{
+    RangePtr<MpmcRing<std::uint32_t>::Cell>(cells)};
+
+  static std::atomic<std::uint8_t> seen[producers][items_per_producer];
+  for (auto & row : seen) for (auto & s : row) s = 0;
+
+  std::atomic<std::uint32_t> consumed{0};
+  std::atomic<bool> order_ok{true};
+
+  std::thread threads[producers + consumers];
+  for (unsigned p = 0; p < producers; ++p) {
+    threads[p] = std::thread([&ring, p] {
+      for (std::uint32_t i = 0; i < items_per_producer; ) {
+        if (ring.try_push((p << 24) | i)) ++i;
+      }
+    });
+  }
+  for (unsigned c = 0; c < consumers; ++c) {
+    threads[producers + c] = std::thread([&] {
+      std::int64_t last[producers];
+      for (auto & l : last) l = -1;
+
+      while (consumed.load() < producers * items_per_producer) {
+        auto m = ring.try_pop();
+        if (!m) continue;
+        consumed.fetch_add(1);
+
+        // Check the tag before indexing with it.  A failure must not end the
+        // thread, or the producers could block on a full ring.
+        auto p = m.ref() >> 24;
+        auto i = m.ref() & 0xFFFFFF;
+        EXPECT_LT(p, producers) << "corrupt value " << m.ref();
+        EXPECT_LT(i, items_per_producer) << "corrupt value " << m.ref();
+        if (p >= producers || i >= items_per_producer) continue;
+
+        if (std::int64_t(i) <= last[p]) order_ok = false;
+        last[p] = i;
+        seen[p][i].fetch_add(1);
+      }
+    });
+  }
+  for (auto & t : threads) t.join();
+
+  EXPECT_TRUE(order_ok.load());
+  EXPECT_EQ(producers * items_per_producer, consumed.load());
+  for (unsigned p = 0; p < producers; ++p) {
+    for (std::uint32_t i = 0; i < items_per_producer; ++i) {
+      ASSERT_EQ(1, seen[p][i].load()) << "producer " << p << " item " << i;
+    }
+  }
+}
+
+}  // namespace data
+}  // namespace etl
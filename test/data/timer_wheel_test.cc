@@ -0,0 +1,240 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/data/timer_wheel.h"
+#include "etl/non_null.h"
+
+#include "test/lcg.h"
+
+using etl::NonNull;
+using etl::null_check;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for the hierarchical timer wheel.
+ *
+ * The wheel has no clock of its own: time only moves when a test calls
+ * advance_to, so everything here is deterministic.  Small wheels (few bits
+ * per level) are used so that cascading between levels, and deadlines past
+ * the span of the whole wheel, happen within a few thousand ticks.
+ */
+
+/*
+ * A connection-like object that embeds its timer.
+ */
+struct Conn {
+  int id = 0;
+  std::uint64_t fired_at = 0;
+  unsigned fire_count = 0;
+  TimerLink timer;
+};
+
+// Three levels of 8 slots each: spans 8, 64 and 512 ticks.
+using Wheel = TimerWheel<Conn, &Conn::timer, 3, 3>;
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(Wheel::bucket_count() == 3 * 8, "");
+static_assert(Wheel::span() == 512, "");
+static_assert(TimerWheel<Conn, &Conn::timer, 4, 6>::bucket_count() == 256,
+              "");
+
+/*******************************************************************************
+ * Dynamic tests - these must be executed.
+ */
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+  static constexpr std::size_t conn_count = 64;
+
+  // The wheel is declared before the connections so that it outlives them,
+  // and TearDown cancels whatever a test left scheduled, so no timer is ever
+  // linked into a dead bucket.
+  Wheel::Bucket buckets[Wheel::bucket_count()];
+  Wheel wheel{RangePtr<Wheel::Bucket>(buckets)};
+  Conn conns[conn_count];
+
+  TimerWheelTest() {
+    for (std::size_t i = 0; i < conn_count; ++i) conns[i].id = int(i);
+  }
+
+  virtual void TearDown() {
+    for (std::size_t i = 0; i < conn_count; ++i) {
+      if (wheel.is_scheduled(conn(i))) wheel.cancel(conn(i));
+    }
+    EXPECT_EQ(0u, wheel.count());
+  }
+
+  NonNull<Conn *> conn(std::size_t i) {
+    return null_check(&conns[i]);
+  }
+
+  // Advances to 'now', recording the time each expired connection fired.
+  std::size_t advance_to(std::uint64_t now) {
+    return wheel.advance_to(now, [this] (Conn & c) {
+      c.fired_at = wheel.now();
+      ++c.fire_count;
+    });
+  }
+
+  // Advances one tick at a time, so fired_at records the exact tick.
+  void step_to(std::uint64_t now) {
+    while (wheel.now() < now) advance_to(wheel.now() + 1);
+  }
+};
+
+constexpr std::size_t TimerWheelTest::conn_count;
+
+TEST_F(TimerWheelTest, StartsAtZero) {
+  EXPECT_EQ(0u, wheel.now());
+  EXPECT_EQ(0u, wheel.count());
+  EXPECT_EQ(0u, advance_to(1000));
+  EXPECT_EQ(1000u, wheel.now());
+}
+
+TEST_F(TimerWheelTest, StorageSizeAsserts) {
+  ASSERT_THROW(Wheel{RangePtr<Wheel::Bucket>(buckets).first(8)},
+               std::logic_error);
+}
+
+TEST_F(TimerWheelTest, FiresOnExactTick) {
+  // Deadlines in each level, at level boundaries, and beyond the span of the
+  // wheel.
+  std::uint64_t deadlines[] {
+    1, 7, 8, 9, 63, 64, 65, 100, 511, 512, 513, 1000, 4097,
+  };
+  std::size_t n = 0;
+  for (auto d : deadlines) wheel.schedule(conn(n++), d);
+  EXPECT_EQ(n, wheel.count());
+
+  step_to(5000);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(1u, conns[i].fire_count) << "deadline " << deadlines[i];
+    EXPECT_EQ(deadlines[i], conns[i].fired_at) << "deadline " << deadlines[i];
+  }
+  EXPECT_EQ(0u, wheel.count());
+}
+
+TEST_F(TimerWheelTest, BatchAdvanceFiresInDeadlineOrder) {
+  std::uint64_t deadlines[] { 300, 5, 70, 9, 1000, 64, 6 };
+  std::size_t n = 0;
+  for (auto d : deadlines) wheel.schedule(conn(n++), d);
+
+  std::size_t order[7];
+  std::size_t fired = 0;
+  auto count = wheel.advance_to(2000, [&] (Conn & c) {
+    order[fired++] = std::size_t(c.id);
+  });
+  EXPECT_EQ(n, count);
+  ASSERT_EQ(n, fired);
+  for (std::size_t i = 1; i < n; ++i) {
+    EXPECT_LE(deadlines[order[i - 1]], deadlines[order[i]]) << "at " << i;
+  }
+}
+
+TEST_F(TimerWheelTest, PastDeadlineFiresOnNextAdvance) {
+  advance_to(100);
+  wheel.schedule(conn(0), 50);
+  EXPECT_EQ(1u, advance_to(101));
+  EXPECT_EQ(101u, conns[0].fired_at);
+}
+
+TEST_F(TimerWheelTest, Cancel) {
+  wheel.schedule(conn(0), 10);
+  wheel.schedule(conn(1), 100);
+  wheel.schedule(conn(2), 1000);
+
+  wheel.cancel(conn(1));
+  wheel.cancel(conn(2));
+  EXPECT_EQ(1u, wheel.count());
+  EXPECT_FALSE(wheel.is_scheduled(conn(1)));
+
+  step_to(2000);
+  EXPECT_EQ(1u, conns[0].fire_count);
+  EXPECT_EQ(0u, conns[1].fire_count);
+  EXPECT_EQ(0u, conns[2].fire_count);
+}
+
+TEST_F(TimerWheelTest, CancelUnscheduledAsserts) {
+  ASSERT_THROW(wheel.cancel(conn(0)), std::logic_error);
+}
+
+TEST_F(TimerWheelTest, Reschedule) {
+  wheel.schedule(conn(0), 10);
+  wheel.reschedule(conn(0), 300);
+  EXPECT_EQ(1u, wheel.count());
+
+  step_to(400);
+  EXPECT_EQ(1u, conns[0].fire_count);
+  EXPECT_EQ(300u, conns[0].fired_at);
+}
+
+TEST_F(TimerWheelTest, CallbackMayReschedule) {
+  // A periodic timer: each expiry schedules the next.
+  wheel.schedule(conn(0), 10);
+  unsigned fires = 0;
+  for (std::uint64_t t = 1; t <= 100; ++t) {
+    wheel.advance_to(t, [&] (Conn & c) {
+      ++fires;
+      EXPECT_EQ(0u, wheel.now() % 10);
+      wheel.schedule(null_check(&c), wheel.now() + 10);
+    });
+  }
+  EXPECT_EQ(10u, fires);
+}
+
+TEST_F(TimerWheelTest, TimeDoesNotGoBackwards) {
+  advance_to(100);
+  ASSERT_THROW(advance_to(99), std::logic_error);
+}
+
+/*
+ * Random schedules, cancels and advances, checked against the deadlines
+ * recorded on the side.
+ */
+TEST_F(TimerWheelTest, RandomAgainstReference) {
+  std::uint64_t deadline[conn_count] {};
+  bool scheduled[conn_count] {};
+  lcg::Gen32 rng(99);
+  auto next = [&rng] { return rng.next(); };
+
+  for (int step = 0; step < 5000; ++step) {
+    auto i = next() % conn_count;
+    auto now = wheel.now();
+
+    if (!scheduled[i]) {
+      deadline[i] = now + 1 + next() % 2000;
+      wheel.schedule(conn(i), deadline[i]);
+      scheduled[i] = true;
+    } else if (next() % 8 == 0) {
+      wheel.cancel(conn(i));
+      scheduled[i] = false;
+    }
+
+    auto target = now + next() % 20;
+    wheel.advance_to(target, [&] (Conn & c) {
+      auto k = std::size_t(c.id);
+      ASSERT_TRUE(scheduled[k]) << "fired an unscheduled timer";
+      ASSERT_LE(deadline[k], target) << "fired early";
+      ASSERT_GT(deadline[k], now) << "fired late";
+      scheduled[k] = false;
+    });
+
+    for (std::size_t k = 0; k < conn_count; ++k) {
+      if (scheduled[k]) {
+        ASSERT_GT(deadline[k], target) << "missed deadline, step " << step;
+      }
+    }
+  }
+}
+
+}  // namespace data
+}  // namespace etl
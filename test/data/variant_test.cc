@@ -0,0 +1,177 @@
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/variant.h"
+#include "etl/type_list.h"
+
+using etl::TypeConstant;
+using etl::TypeList;
+using etl::data::Variant;
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+struct Small { std::uint8_t x; };
+struct Big { std::uint64_t a, b; };
+struct Odd { char c[5]; };
+
+using SBO = Variant<Small, Big, Odd>;
+
+static_assert(std::is_same<SBO::Types, TypeList<Small, Big, Odd>>::value,
+              "Variant must expose its alternatives as a TypeList.");
+static_assert(alignof(SBO) == etl::MaxAlignOf<SBO::Types>::value,
+              "Variant alignment must come from MaxAlignOf.");
+static_assert(sizeof(SBO) <= etl::MaxSizeOf<SBO::Types>::value
+                             + etl::MaxAlignOf<SBO::Types>::value,
+              "Variant storage must be sized by MaxSizeOf, plus a tag.");
+static_assert(sizeof(Variant<std::uint8_t, std::uint16_t>) == 4, "");
+
+/*******************************************************************************
+ * dispatch
+ */
+
+/*
+ * Reports the size of the type selected by the index.
+ */
+struct SizeOfFn {
+  template <typename T>
+  std::size_t operator()(TypeConstant<T>) const {
+    return sizeof(T);
+  }
+};
+
+TEST(Dispatch, SelectsByIndex) {
+  using L = TypeList<std::uint8_t, std::uint32_t, Big>;
+  EXPECT_EQ(1u, etl::dispatch<L>(0, SizeOfFn{}));
+  EXPECT_EQ(4u, etl::dispatch<L>(1, SizeOfFn{}));
+  EXPECT_EQ(sizeof(Big), etl::dispatch<L>(2, SizeOfFn{}));
+}
+
+TEST(Dispatch, OutOfRangeAsserts) {
+  using L = TypeList<std::uint8_t, std::uint32_t>;
+  ASSERT_THROW(etl::dispatch<L>(2, SizeOfFn{}), std::logic_error);
+}
+
+TEST(Dispatch, ManyAlternatives) {
+  // Large enough that an if-chain would be obvious in a profile; this just
+  // checks the table is built correctly end to end.
+  using L = etl::Repeat<Small, 40>;
+  for (std::size_t i = 0; i < L::size(); ++i) {
+    EXPECT_EQ(sizeof(Small), etl::dispatch<L>(i, SizeOfFn{}));
+  }
+}
+
+/*******************************************************************************
+ * Variant
+ */
+
+/*
+ * Counts live instances, like LifeSpy in maybe_test, but only as much as
+ * needed here.
+ */
+struct Counted {
+  static int alive;
+  int value;
+
+  explicit Counted(int v) : value(v) { ++alive; }
+  Counted(Counted const & other) : value(other.value) { ++alive; }
+  Counted(Counted && other) : value(other.value) { ++alive; }
+  ~Counted() { --alive; }
+};
+
+int Counted::alive = 0;
+
+using V = Variant<int, Counted, Big>;
+
+class VariantTest : public ::testing::Test {
+protected:
+  // Every test must leave behind exactly what it found: nothing.  Resetting
+  // the count instead would hide a leak in the previous test.
+  virtual void TearDown() {
+    EXPECT_EQ(0, Counted::alive) << "a Counted was leaked or double-freed";
+  }
+};
+
+TEST_F(VariantTest, ConstructAndQuery) {
+  V v(42);
+  EXPECT_EQ(0u, v.index());
+  EXPECT_TRUE(v.is<int>());
+  EXPECT_FALSE(v.is<Counted>());
+  EXPECT_EQ(42, v.get<int>());
+}
+
+TEST_F(VariantTest, WrongGetAsserts) {
+  V v(42);
+  ASSERT_THROW(v.get<Big>(), std::logic_error);
+}
+
+TEST_F(VariantTest, DestroysContents) {
+  {
+    V v(Counted(3));
+    EXPECT_EQ(1u, v.index());
+    EXPECT_EQ(3, v.get<Counted>().value);
+    EXPECT_EQ(1, Counted::alive);
+  }
+  EXPECT_EQ(0, Counted::alive);
+}
+
+TEST_F(VariantTest, AssignmentChangesAlternative) {
+  V v(Counted(3));
+  EXPECT_EQ(1, Counted::alive);
+
+  v = Big{1, 2};
+  EXPECT_EQ(0, Counted::alive)
+    << "Switching alternatives must destroy the old one.";
+  EXPECT_TRUE(v.is<Big>());
+  EXPECT_EQ(2u, v.get<Big>().b);
+
+  v = Counted(5);
+  EXPECT_EQ(1, Counted::alive);
+  EXPECT_EQ(5, v.get<Counted>().value);
+}
+
+TEST_F(VariantTest, Copy) {
+  V v(Counted(3));
+  V w(v);
+  EXPECT_EQ(2, Counted::alive);
+  EXPECT_EQ(3, w.get<Counted>().value);
+
+  V x(7);
+  x = w;
+  EXPECT_EQ(3, Counted::alive);
+  EXPECT_EQ(3, x.get<Counted>().value);
+}
+
+/*
+ * An overloaded visitor that records which alternative it saw.
+ */
+struct NameFn {
+  char const * operator()(int) const { return "int"; }
+  char const * operator()(Counted const &) const { return "Counted"; }
+  char const * operator()(Big const &) const { return "Big"; }
+};
+
+TEST_F(VariantTest, Visit) {
+  EXPECT_STREQ("int", visit(V(1), NameFn{}));
+  EXPECT_STREQ("Counted", visit(V(Counted(1)), NameFn{}));
+  EXPECT_STREQ("Big", visit(V(Big{1, 2}), NameFn{}));
+}
+
+/*
+ * A visitor that modifies the contents in place.
+ */
+struct DoubleFn {
+  void operator()(int & x) const { x *= 2; }
+  void operator()(Counted & c) const { c.value *= 2; }
+  void operator()(Big & b) const { b.a *= 2; }
+};
+
+TEST_F(VariantTest, VisitMutates) {
+  V v(Counted(21));
+  visit(v, DoubleFn{});
+  EXPECT_EQ(42, v.get<Counted>().value);
+}
@@ -0,0 +1,309 @@
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/data/vector.h"
+#include "etl/mem/arena.h"
+
+using etl::mem::Arena;
+
+namespace etl {
+namespace data {
+
+/*
+ * Tests for StaticVector and SmallVector.
+ */
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(StaticVector<int, 4>::capacity() == 4, "");
+static_assert(sizeof(StaticVector<std::uint32_t, 4>)
+                <= 4 * sizeof(std::uint32_t) + sizeof(std::size_t),
+              "StaticVector should be its elements plus a count.");
+
+static_assert(IsTriviallyRelocatable<int>::value, "");
+static_assert(IsTriviallyRelocatable<RangePtr<int>>::value,
+              "Trivially copyable types are trivially relocatable.");
+
+/*******************************************************************************
+ * Lifecycle tracking.
+ */
+
+/*
+ * Counts constructions, moves and destructions, in the spirit of LifeSpy in
+ * maybe_test.  Each instance carries a value, so that the tests can check
+ * contents survive relocation.
+ */
+struct Tracked {
+  static unsigned alive, moves, copies;
+
+  // Zeroes the operation counts.  alive is never reset: each test must bring
+  // it back to zero itself, which the fixtures check.
+  static void reset_counts() {
+    moves = copies = 0;
+  }
+
+  int value;
+
+  explicit Tracked(int v) : value(v) { ++alive; }
+  Tracked(Tracked const & other) : value(other.value) { ++alive; ++copies; }
+  Tracked(Tracked && other) : value(other.value) {
+    ++alive;
+    ++moves;
+    other.value = -1;
+  }
+  Tracked & operator=(Tracked const & other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  Tracked & operator=(Tracked && other) {
+    value = other.value;
+    ++moves;
+    other.value = -1;
+    return *this;
+  }
+  ~Tracked() { --alive; }
+};
+
+unsigned Tracked::alive, Tracked::moves, Tracked::copies;
+
+/*
+ * The same, but declared trivially relocatable, so containers may move it
+ * with memcpy and skip both the move constructor and the destructor of the
+ * source.
+ */
+struct Relocatable : Tracked {
+  using Tracked::Tracked;
+};
+
+template <>
+struct IsTriviallyRelocatable<Relocatable> : std::true_type {};
+
+static_assert(!IsTriviallyRelocatable<Tracked>::value, "");
+
+/*******************************************************************************
+ * StaticVector
+ */
+
+class StaticVectorTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    Tracked::reset_counts();
+  }
+
+  virtual void TearDown() {
+    EXPECT_EQ(0u, Tracked::alive) << "a Tracked was leaked or double-freed";
+  }
+};
+
+TEST_F(StaticVectorTest, PushPop) {
+  StaticVector<int, 4> v;
+  EXPECT_TRUE(v.is_empty());
+  v.push_back(1);
+  v.push_back(2);
+  v.emplace_back(3);
+  EXPECT_EQ(3u, v.size());
+  EXPECT_EQ(2, v[1]);
+
+  v.pop_back();
+  EXPECT_EQ(2u, v.size());
+  EXPECT_EQ(2, v.back());
+}
+
+TEST_F(StaticVectorTest, FullAsserts) {
+  StaticVector<int, 2> v;
+  v.push_back(1);
+  v.push_back(2);
+  ASSERT_THROW(v.push_back(3), std::logic_error);
+}
+
+TEST_F(StaticVectorTest, EmptyPopAsserts) {
+  StaticVector<int, 2> v;
+  ASSERT_THROW(v.pop_back(), std::logic_error);
+}
+
+TEST_F(StaticVectorTest, ConvertsToRangePtr) {
+  StaticVector<int, 8> v;
+  for (int i = 0; i < 5; ++i) v.push_back(i);
+
+  RangePtr<int> r = v;
+  EXPECT_EQ(5u, r.count()) << "the range must cover only live elements";
+  EXPECT_EQ(&v[0], r.base());
+
+  StaticVector<int, 8> const & cv = v;
+  RangePtr<int const> cr = cv;
+  EXPECT_EQ(5u, cr.count());
+}
+
+TEST_F(StaticVectorTest, DestroysLiveElementsOnly) {
+  {
+    StaticVector<Tracked, 8> v;
+    v.emplace_back(1);
+    v.emplace_back(2);
+    EXPECT_EQ(2u, Tracked::alive)
+      << "unused capacity must not be constructed";
+    v.pop_back();
+    EXPECT_EQ(1u, Tracked::alive);
+  }
+  EXPECT_EQ(0u, Tracked::alive);
+}
+
+TEST_F(StaticVectorTest, Copy) {
+  StaticVector<Tracked, 4> v;
+  v.emplace_back(1);
+  v.emplace_back(2);
+
+  auto w = v;
+  EXPECT_EQ(4u, Tracked::alive);
+  EXPECT_EQ(2u, Tracked::copies);
+  EXPECT_EQ(2, w[1].value);
+}
+
+TEST_F(StaticVectorTest, MoveUsesMoveConstructor) {
+  StaticVector<Tracked, 4> v;
+  v.emplace_back(1);
+  v.emplace_back(2);
+
+  auto w = std::move(v);
+  EXPECT_EQ(2u, Tracked::moves);
+  EXPECT_EQ(2u, Tracked::alive) << "moved-from elements must be destroyed";
+  EXPECT_TRUE(v.is_empty());
+  EXPECT_EQ(2, w[1].value);
+}
+
+TEST_F(StaticVectorTest, MoveRelocatesTriviallyRelocatable) {
+  StaticVector<Relocatable, 4> v;
+  v.emplace_back(1);
+  v.emplace_back(2);
+
+  auto w = std::move(v);
+  EXPECT_EQ(0u, Tracked::moves) << "relocation must bypass the move ctor";
+  EXPECT_EQ(2u, Tracked::alive) << "relocation must not destroy the source";
+  EXPECT_TRUE(v.is_empty());
+  EXPECT_EQ(1, w[0].value);
+  EXPECT_EQ(2, w[1].value);
+}
+
+/*******************************************************************************
+ * SmallVector
+ */
+
+class SmallVectorTest : public ::testing::Test {
+protected:
+  std::uint8_t region[1024];
+  Arena<> arena{region};
+
+  virtual void SetUp() {
+    arena.reset();
+    Tracked::reset_counts();
+  }
+
+  virtual void TearDown() {
+    EXPECT_EQ(0u, Tracked::alive) << "a Tracked was leaked or double-freed";
+  }
+
+  bool is_in_region(void const * p) {
+    return p >= &region[0] && p < &region[sizeof(region)];
+  }
+};
+
+TEST_F(SmallVectorTest, InlineUntilFull) {
+  SmallVector<int, 4> v(arena);
+  auto free_before = arena.get_free_count();
+  for (int i = 0; i < 4; ++i) v.push_back(i);
+
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(free_before, arena.get_free_count())
+    << "a SmallVector within its inline capacity must not allocate";
+  EXPECT_FALSE(is_in_region(&v[0]));
+}
+
+TEST_F(SmallVectorTest, Spills) {
+  SmallVector<int, 4> v(arena);
+  for (int i = 0; i < 20; ++i) v.push_back(i * i);
+
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_TRUE(is_in_region(&v[0]));
+  EXPECT_GE(v.capacity(), 20u);
+  for (int i = 0; i < 20; ++i) EXPECT_EQ(i * i, v[std::size_t(i)]);
+
+  RangePtr<int> r = v;
+  EXPECT_EQ(20u, r.count());
+}
+
+TEST_F(SmallVectorTest, SpillFailureAsserts) {
+  std::uint8_t tiny[8];
+  Arena<> tiny_arena(tiny);
+  // Reset, or the arena is exhausted from the start and the spill fails for
+  // the wrong reason.
+  tiny_arena.reset();
+  SmallVector<int, 2> v(tiny_arena);
+  v.push_back(1);
+  v.push_back(2);
+  ASSERT_THROW(
+      for (int i = 0; i < 100; ++i) v.push_back(i),
+      std::logic_error);
+}
+
+TEST_F(SmallVectorTest, SpillMovesElements) {
+  {
+    SmallVector<Tracked, 2> v(arena);
+    v.emplace_back(1);
+    v.emplace_back(2);
+    v.emplace_back(3);
+
+    EXPECT_EQ(2u, Tracked::moves) << "the inline elements move on spill";
+    EXPECT_EQ(3u, Tracked::alive);
+    EXPECT_EQ(1, v[0].value);
+    EXPECT_EQ(3, v[2].value);
+  }
+  EXPECT_EQ(0u, Tracked::alive);
+}
+
+TEST_F(SmallVectorTest, SpillRelocatesTriviallyRelocatable) {
+  SmallVector<Relocatable, 2> v(arena);
+  v.emplace_back(1);
+  v.emplace_back(2);
+  v.emplace_back(3);
+
+  EXPECT_EQ(0u, Tracked::moves);
+  EXPECT_EQ(3u, Tracked::alive);
+  EXPECT_EQ(1, v[0].value);
+  EXPECT_EQ(3, v[2].value);
+}
+
+TEST_F(SmallVectorTest, MoveOfSpilledStealsStorage) {
+  SmallVector<Tracked, 2> v(arena);
+  for (int i = 0; i < 5; ++i) v.emplace_back(i);
+  auto moves_before = Tracked::moves;
+  auto base = &v[0];
+
+  auto w = std::move(v);
+  EXPECT_EQ(moves_before, Tracked::moves)
+    << "moving a spilled vector must not touch its elements";
+  EXPECT_EQ(base, &w[0]);
+  EXPECT_EQ(5u, w.size());
+  EXPECT_TRUE(v.is_empty());
+}
+
+TEST_F(SmallVectorTest, MoveOfInlineMovesElements) {
+  SmallVector<Tracked, 4> v(arena);
+  v.emplace_back(1);
+  v.emplace_back(2);
+
+  auto w = std::move(v);
+  EXPECT_EQ(2u, Tracked::moves);
+  EXPECT_EQ(2u, Tracked::alive);
+  EXPECT_TRUE(w.is_inline());
+  EXPECT_EQ(2, w[1].value);
+}
+
+}  // namespace data
+}  // namespace etl
@@ -0,0 +1,110 @@
+/*
+ * Success-path cost of the error flow macros.
+ *
+ * Each benchmark runs a chain of eight fallible steps that all succeed.  The
+ * "plain" variant spells out the conditional return that ETL_CHECK used to
+ * expand to; the "check" variant uses ETL_CHECK itself, which now carries a
+ * branch hint and routes the failure through a cold helper.  Comparing the
+ * two shows what the error path costs the success path.
+ *
+ * The "result" variants do the same over Result, whose is_error() carries
+ * the same hint: once tested by hand, and once through ETL_CHECK on the
+ * result's status.
+ */
+
+#include "etl/attribute_macros.h"
+#include "etl/error/flow.h"
+#include "etl/error/result.h"
+
+#include "test/bench.h"
+#include "test_error.h"
+
+static constexpr unsigned long iterations = 10000000;
+
+ETL_NOINLINE static TestError step(unsigned long i) {
+  // Fails only for an input the benchmark never produces.
+  return bench::opaque(i) == ~0ul ? TestError::failure_1 : TestError::ok;
+}
+
+#define PLAIN_CHECK(expr) \
+  { \
+    TestError _e = (expr); \
+    if (_e != TestError::ok) return _e; \
+  }
+
+ETL_NOINLINE static TestError plain_chain(unsigned long i) {
+  PLAIN_CHECK(step(i));
+  PLAIN_CHECK(step(i + 1));
+  PLAIN_CHECK(step(i + 2));
+  PLAIN_CHECK(step(i + 3));
+  PLAIN_CHECK(step(i + 4));
+  PLAIN_CHECK(step(i + 5));
+  PLAIN_CHECK(step(i + 6));
+  PLAIN_CHECK(step(i + 7));
+  return TestError::ok;
+}
+
+#undef PLAIN_CHECK
+
+ETL_NOINLINE static TestError check_chain(unsigned long i) {
+  ETL_CHECK(step(i));
+  ETL_CHECK(step(i + 1));
+  ETL_CHECK(step(i + 2));
+  ETL_CHECK(step(i + 3));
+  ETL_CHECK(step(i + 4));
+  ETL_CHECK(step(i + 5));
+  ETL_CHECK(step(i + 6));
+  ETL_CHECK(step(i + 7));
+  return TestError::ok;
+}
+
+using ResultT = etl::error::Result<TestError, unsigned long>;
+
+ETL_NOINLINE static ResultT result_step(unsigned long i) {
+  if (bench::opaque(i) == ~0ul) return {etl::error::left, TestError::failure_1};
+  return {etl::error::right, i};
+}
+
+ETL_NOINLINE static TestError result_chain(unsigned long i) {
+  unsigned long sum = 0;
+  for (unsigned long k = 0; k < 8; ++k) {
+    auto r = result_step(i + k);
+    if (r.is_error()) return r.get_status();
+    sum += r.ref();
+  }
+  bench::keep(sum);
+  return TestError::ok;
+}
+
+ETL_NOINLINE static TestError result_check_chain(unsigned long i) {
+  unsigned long sum = 0;
+  for (unsigned long k = 0; k < 8; ++k) {
+    auto r = result_step(i + k);
+    ETL_CHECK(r.is_error() ? r.get_status() : TestError::ok);
+    sum += r.ref();
+  }
+  bench::keep(sum);
+  return TestError::ok;
+}
+
+int main() {
+  bench::print_header();
+
+  bench::run("flow.plain_chain", iterations, [] (unsigned long i) {
+    bench::keep(plain_chain(i));
+  });
+
+  bench::run("flow.check_chain", iterations, [] (unsigned long i) {
+    bench::keep(check_chain(i));
+  });
+
+  bench::run("flow.result_chain", iterations, [] (unsigned long i) {
+    bench::keep(result_chain(i));
+  });
+
+  bench::run("flow.result_check_chain", iterations, [] (unsigned long i) {
+    bench::keep(result_check_chain(i));
+  });
+
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include "etl/attribute_macros.h"
+#include "etl/error/check.h"
+#include "etl/error/flow.h"
+#include "etl/error/result.h"
+
+#include "test_error.h"
+
+/*
+ * Tests for the branch hints and cold failure paths in the error flow macros
+ * and Result.  These only check that the hints leave behavior alone; their
+ * effect on code layout is measured by flow_bench.
+ */
+
+namespace etl {
+namespace error {
+
+template <typename V>
+using TResult = Result<TestError, V>;
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+/*
+ * The hints must not change the value of the condition, and must remain
+ * usable in constant expressions.
+ */
+static_assert(ETL_LIKELY(true), "");
+static_assert(!ETL_LIKELY(false), "");
+static_assert(ETL_UNLIKELY(true), "");
+static_assert(!ETL_UNLIKELY(false), "");
+static_assert(ETL_UNLIKELY(2 + 2 == 4), "");
+
+// Result::is_error is hinted, and must stay constexpr.
+static_assert(TResult<int>(left, TestError::failure_1).is_error(), "");
+static_assert(!TResult<int>(right, 1).is_error(), "");
+
+/*******************************************************************************
+ * Dynamic tests - these must be executed.
+ */
+
+static TestError success_func() { return TestError::ok; }
+static TestError failure2_func() { return TestError::failure_2; }
+
+static TResult<unsigned> result_func(unsigned i) {
+  if (i == 3) return {left, TestError::failure_1};
+  return {right, i};
+}
+
+TEST(CATCH, Success) {
+  TestError e = [] {
+    return ETL_CATCH(success_func());
+  }();
+  ASSERT_EQ(TestError::ok, e);
+}
+
+TEST(CHECK, FailureInLoop) {
+  // The failure path is out of line; make sure it still exits from the
+  // middle of a loop with the right value.
+  unsigned iterations = 0;
+  TestError e = [&iterations] {
+    for (unsigned i = 0; i < 10; ++i) {
+      ++iterations;
+      ETL_CHECK(i == 3 ? failure2_func() : success_func());
+    }
+    return TestError::ok;
+  }();
+  ASSERT_EQ(TestError::failure_2, e);
+  ASSERT_EQ(4u, iterations);
+}
+
+TEST(Result, IsErrorInLoop) {
+  unsigned sum = 0;
+  TestError e = TestError::ok;
+  for (unsigned i = 0; i < 10; ++i) {
+    auto r = result_func(i);
+    if (r.is_error()) {
+      e = r.get_status();
+      break;
+    }
+    sum += r.ref();
+  }
+  ASSERT_EQ(TestError::failure_1, e);
+  ASSERT_EQ(0u + 1u + 2u, sum);
+}
+
+}  // namespace error
+}  // namespace etl
@@ -0,0 +1,171 @@
+#include <cstring>
+#include <thread>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "etl/error/flow.h"
+#include "etl/error/trace.h"
+
+#include "test_error.h"
+
+/*
+ * Tests for error-origin tracing.  These are only meaningful when tracing is
+ * compiled in, so they're built into their own runner with
+ * etl_config_error_trace set; see //test:error_trace_tests.
+ */
+
+namespace etl {
+namespace error {
+namespace trace {
+
+static_assert(enabled, "trace tests must be built with tracing enabled");
+
+static TestError success_func() { return TestError::ok; }
+static TestError failure1_func() { return TestError::failure_1; }
+
+/*
+ * A three-frame chain.  Each frame records the line of its ETL_CHECK so that
+ * the tests can verify the trace without hardcoding line numbers.
+ */
+
+static int leaf_line;
+static int middle_line;
+static int top_line;
+
+static TestError leaf() {
+  ETL_CHECK(success_func());
+  leaf_line = __LINE__; ETL_CHECK(failure1_func());
+  return TestError::ok;
+}
+
+static TestError middle() {
+  middle_line = __LINE__; ETL_CHECK(leaf());
+  return TestError::ok;
+}
+
+static TestError top() {
+  top_line = __LINE__; ETL_CHECK(middle());
+  return TestError::ok;
+}
+
+class TraceTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    clear();
+  }
+
+  Record records[capacity];
+
+  std::size_t snapshot() {
+    return copy_out(records);
+  }
+};
+
+TEST_F(TraceTest, EmptyAfterClear) {
+  ASSERT_EQ(0u, snapshot());
+}
+
+TEST_F(TraceTest, SuccessRecordsNothing) {
+  TestError e = [] {
+    ETL_CHECK(success_func());
+    ETL_CHECK(success_func());
+    return TestError::ok;
+  }();
+  ASSERT_EQ(TestError::ok, e);
+  ASSERT_EQ(0u, snapshot());
+}
+
+TEST_F(TraceTest, CatchRecordsNothing) {
+  TestError e = [] {
+    return ETL_CATCH(failure1_func());
+  }();
+  ASSERT_EQ(TestError::failure_1, e);
+  ASSERT_EQ(0u, snapshot());
+}
+
+TEST_F(TraceTest, ChainRecordedOldestFirst) {
+  ASSERT_EQ(TestError::failure_1, top());
+  ASSERT_EQ(3u, snapshot());
+
+  EXPECT_EQ(leaf_line, records[0].line);
+  EXPECT_EQ(middle_line, records[1].line);
+  EXPECT_EQ(top_line, records[2].line);
+
+  for (unsigned i = 0; i < 3; ++i) {
+    EXPECT_STREQ(__FILE__, records[i].file) << "record " << i;
+    EXPECT_EQ(static_cast<int>(TestError::failure_1), records[i].code)
+      << "record " << i;
+  }
+}
+
+TEST_F(TraceTest, OldestRecordsOverwritten) {
+  std::size_t const chains = capacity / 3 + 2;
+  for (std::size_t i = 0; i < chains; ++i) {
+    top();
+  }
+
+  ASSERT_EQ(capacity, snapshot());
+  // The newest record is always the outermost frame of the last chain.
+  EXPECT_EQ(top_line, records[capacity - 1].line);
+  EXPECT_EQ(middle_line, records[capacity - 2].line);
+  EXPECT_EQ(leaf_line, records[capacity - 3].line);
+}
+
+TEST_F(TraceTest, CopyOutTruncatesToNewest) {
+  top();
+
+  Record two[2];
+  ASSERT_EQ(2u, copy_out(two));
+  EXPECT_EQ(middle_line, two[0].line);
+  EXPECT_EQ(top_line, two[1].line);
+}
+
+TEST_F(TraceTest, PerThread) {
+  top();
+
+  std::size_t other_count = ~std::size_t(0);
+  std::thread t([&other_count] {
+    Record other[capacity];
+    other_count = copy_out(other);
+    top();
+  });
+  t.join();
+
+  EXPECT_EQ(0u, other_count)
+    << "a new thread must start with an empty trace";
+  EXPECT_EQ(3u, snapshot())
+    << "records from other threads must not appear in this one";
+}
+
+TEST_F(TraceTest, DumpToFd) {
+  top();
+
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  dump(fds[1]);
+  close(fds[1]);
+
+  char text[4096];
+  std::size_t length = 0;
+  for (;;) {
+    auto n = read(fds[0], text + length, sizeof(text) - 1 - length);
+    if (n <= 0) break;
+    length += static_cast<std::size_t>(n);
+  }
+  close(fds[0]);
+  text[length] = '\0';
+
+  // One line per record.
+  unsigned lines = 0;
+  for (std::size_t i = 0; i < length; ++i) {
+    if (text[i] == '\n') ++lines;
+  }
+  EXPECT_EQ(3u, lines);
+  EXPECT_NE(nullptr, std::strstr(text, __FILE__));
+}
+
+}  // namespace trace
+}  // namespace error
+}  // namespace etl
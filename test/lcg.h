@@ -0,0 +1,51 @@
+#ifndef TEST_LCG_H
+#define TEST_LCG_H
+
+/*
+ * Deterministic pseudo-random inputs for tests.
+ *
+ * Tests want inputs that are the same on every run and every host, not good
+ * randomness, so these are plain linear congruential generators.
+ */
+
+#include <cstdint>
+
+namespace lcg {
+
+/*
+ * The classic C library generator.  Its low bits are weak, so next() drops
+ * the bottom eight and returns 24 bits.
+ */
+class Gen32 {
+ public:
+  explicit constexpr Gen32(std::uint32_t seed = 1) : _state(seed) {}
+
+  std::uint32_t next() {
+    _state = _state * 1103515245u + 12345u;
+    return _state >> 8;
+  }
+
+ private:
+  std::uint32_t _state;
+};
+
+/*
+ * Knuth's MMIX generator.  next() returns the whole state; callers wanting
+ * fewer bits should take them from the top.
+ */
+class Gen64 {
+ public:
+  explicit constexpr Gen64(std::uint64_t seed = 1) : _state(seed) {}
+
+  std::uint64_t next() {
+    _state = _state * 6364136223846793005u + 1442695040888963407u;
+    return _state;
+  }
+
+ private:
+  std::uint64_t _state;
+};
+
+}  // namespace lcg
+
+#endif  // TEST_LCG_H
@@ -0,0 +1,97 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/math/affine_transform.h"
+#include "etl/math/linear_transform.h"
+#include "etl/math/matrix.h"
+#include "etl/math/vector.h"
+
+using namespace etl::math::affine_transform;
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for Affine3, the compact linear-plus-translation form.  Each is
+ * checked against the equivalent full 4x4 homogeneous computation, as tested
+ * in affine_test.
+ */
+
+/*******************************************************************************
+ * Static tests - these pass if the test compiles.
+ */
+
+static_assert(sizeof(Affine3<float>) == 12 * sizeof(float),
+              "Affine3 should store only the linear part and translation.");
+
+static constexpr auto expected_translate = Matrix<4, 4, int> {
+  {1, 0, 0, 3},
+  {0, 1, 0, 4},
+  {0, 0, 1, 5},
+  {0, 0, 0, 1},
+};
+
+static constexpr auto expected_scale = Matrix<4, 4, int> {
+  {10, 0, 0, 0},
+  {0, 20, 0, 0},
+  {0, 0, 30, 0},
+  {0, 0, 0,  1},
+};
+
+static constexpr auto p = Vec3f{1, 2, 3};
+
+static constexpr auto t = Affine3<float>::from_translation(Vec3f{3, 4, 5});
+static constexpr auto s = Affine3<float>::from_linear(
+    linear_transform::scale(Vec3f{10, 20, 30}));
+
+static_assert(Affine3<float>::identity() * p == p, "");
+static_assert(t * p == Vec3f{4, 6, 8}, "");
+static_assert(s * p == Vec3f{10, 40, 90}, "");
+
+// Composition applies the right-hand transform first, like matrices do.
+static_assert((t * s) * p == Vec3f{13, 44, 95}, "");
+static_assert((s * t) * p == Vec3f{40, 120, 240}, "");
+static_assert((t * s) * p
+        == project(translate(Vec3f{3, 4, 5})
+                   * scale(Vec3f{10, 20, 30})
+                   * augment(p)), "");
+
+// Conversion to and from the 4x4 form.
+static_assert(to_matrix(t) == expected_translate, "");
+static_assert(to_matrix(s) == expected_scale, "");
+static_assert(to_matrix(t * s)
+        == translate(Vec3f{3, 4, 5}) * scale(Vec3f{10, 20, 30}), "");
+static_assert(Affine3<float>::from_matrix(expected_translate) * p
+        == Vec3f{4, 6, 8}, "");
+static_assert(to_matrix(Affine3<float>::from_matrix(
+                  translate(Vec3f{3, 4, 5}) * scale(Vec3f{10, 20, 30})))
+        == translate(Vec3f{3, 4, 5}) * scale(Vec3f{10, 20, 30}), "");
+
+/*******************************************************************************
+ * Dynamic tests - these must be executed.
+ */
+
+TEST(Affine3, from_non_affine_matrix_asserts) {
+  auto projective = Matrix<4, 4, float> {
+    {1, 0, 0, 0},
+    {0, 1, 0, 0},
+    {0, 0, 1, 0},
+    {0, 0, 1, 0},
+  };
+  ASSERT_THROW(Affine3<float>::from_matrix(projective), std::logic_error);
+}
+
+TEST(Affine3, matches_homogeneous_transform) {
+  auto m = translate(Vec3f{-1, 0.5f, 2})
+         * scale(Vec3f{2, 3, 4})
+         * translate(Vec3f{1, 1, 1});
+  auto a = Affine3<float>::from_matrix(m);
+
+  for (auto q : {Vec3f{0, 0, 0}, Vec3f{1, -1, 2}, Vec3f{0.25f, 8, -3}}) {
+    ASSERT_EQ(project(m * augment(q)), a * q);
+  }
+}
+
+}  // namespace math
+}  // namespace etl
@@ -0,0 +1,189 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/math/approx.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace math {
+namespace approx {
+
+/*
+ * Tests for the polynomial approximations of the transcendental functions.
+ *
+ * Each function is swept over its domain and compared against the C library
+ * evaluated in double precision, which serves as the reference.  The
+ * documented bounds in approx.h are what we check against, so tightening a
+ * bound there without improving the kernel fails here.
+ *
+ * sin, cos and atan2 are bounded in absolute error, since their results pass
+ * through zero and relative error is meaningless there.  sqrt and rsqrt are
+ * bounded in ULPs.
+ */
+
+static std::int64_t ordered_bits(float f) {
+  std::int32_t i;
+  std::memcpy(&i, &f, sizeof(i));
+  // Map sign-magnitude to two's complement so that adjacent floats differ by
+  // one, across zero as well.
+  return i < 0 ? std::int64_t(INT32_MIN) - i : i;
+}
+
+static std::uint32_t ulp_distance(float a, float b) {
+  auto ia = ordered_bits(a);
+  auto ib = ordered_bits(b);
+  return std::uint32_t(ia > ib ? ia - ib : ib - ia);
+}
+
+static constexpr unsigned steps = 100000;
+
+static float lerp(float lo, float hi, unsigned i) {
+  return lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(steps);
+}
+
+/*******************************************************************************
+ * Scalar forms.
+ */
+
+TEST(Approx, sin) {
+  float worst = 0;
+  for (unsigned i = 0; i <= steps; ++i) {
+    float x = lerp(-8 * float(M_PI), 8 * float(M_PI), i);
+    float err = std::fabs(sin(x) - float(std::sin(double(x))));
+    if (err > worst) worst = err;
+  }
+  EXPECT_LE(worst, sin_max_abs_error);
+}
+
+TEST(Approx, cos) {
+  float worst = 0;
+  for (unsigned i = 0; i <= steps; ++i) {
+    float x = lerp(-8 * float(M_PI), 8 * float(M_PI), i);
+    float err = std::fabs(cos(x) - float(std::cos(double(x))));
+    if (err > worst) worst = err;
+  }
+  EXPECT_LE(worst, cos_max_abs_error);
+}
+
+TEST(Approx, exact_points) {
+  EXPECT_EQ(0.f, sin(0.f));
+  EXPECT_EQ(1.f, cos(0.f));
+}
+
+TEST(Approx, atan2) {
+  float worst = 0;
+  for (unsigned i = 0; i <= 400; ++i) {
+    for (unsigned j = 0; j <= 400; ++j) {
+      float y = -10.f + 0.05f * static_cast<float>(i);
+      float x = -10.f + 0.05f * static_cast<float>(j);
+      float err = std::fabs(atan2(y, x)
+                            - float(std::atan2(double(y), double(x))));
+      if (err > worst) worst = err;
+    }
+  }
+  EXPECT_LE(worst, atan2_max_abs_error);
+}
+
+TEST(Approx, atan2_axes) {
+  EXPECT_NEAR(0.f, atan2(0.f, 1.f), atan2_max_abs_error);
+  EXPECT_NEAR(float(M_PI) / 2, atan2(1.f, 0.f), atan2_max_abs_error);
+  EXPECT_NEAR(float(M_PI), atan2(0.f, -1.f), atan2_max_abs_error);
+  EXPECT_NEAR(-float(M_PI) / 2, atan2(-1.f, 0.f), atan2_max_abs_error);
+}
+
+TEST(Approx, sqrt) {
+  std::uint32_t worst = 0;
+  // Log-spaced over [1e-6, 1e6] so every exponent gets coverage.
+  for (unsigned i = 0; i <= steps; ++i) {
+    float x = float(std::pow(10., double(lerp(-6.f, 6.f, i))));
+    auto err = ulp_distance(sqrt(x), float(std::sqrt(double(x))));
+    if (err > worst) worst = err;
+  }
+  EXPECT_LE(worst, sqrt_max_ulp);
+}
+
+TEST(Approx, sqrt_zero) {
+  EXPECT_EQ(0.f, sqrt(0.f));
+}
+
+TEST(Approx, rsqrt) {
+  std::uint32_t worst = 0;
+  for (unsigned i = 0; i <= steps; ++i) {
+    float x = float(std::pow(10., double(lerp(-6.f, 6.f, i))));
+    auto err = ulp_distance(rsqrt(x), float(1. / std::sqrt(double(x))));
+    if (err > worst) worst = err;
+  }
+  EXPECT_LE(worst, rsqrt_max_ulp);
+}
+
+/*******************************************************************************
+ * Range forms, which must agree with the scalar forms exactly so that
+ * callers can mix them freely.  37 elements exercises any vector remainder.
+ */
+
+class ApproxRange : public ::testing::Test {
+protected:
+  static constexpr std::size_t count = 37;
+  float in[count];
+  float out[count];
+
+  virtual void SetUp() {
+    for (std::size_t i = 0; i < count; ++i) {
+      in[i] = 0.25f + 0.5f * static_cast<float>(i);
+    }
+  }
+};
+
+constexpr std::size_t ApproxRange::count;
+
+TEST_F(ApproxRange, sin) {
+  sin(RangePtr<float const>(in), RangePtr<float>(out));
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(sin(in[i]), out[i]) << "at " << i;
+  }
+}
+
+TEST_F(ApproxRange, cos) {
+  cos(RangePtr<float const>(in), RangePtr<float>(out));
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(cos(in[i]), out[i]) << "at " << i;
+  }
+}
+
+TEST_F(ApproxRange, atan2) {
+  // Alternate the sign of y and run x through zero, to reach every quadrant.
+  float y[count], x[count];
+  for (std::size_t i = 0; i < count; ++i) {
+    y[i] = i % 2 ? -in[i] : in[i];
+    x[i] = 3.f - 0.25f * static_cast<float>(i);
+  }
+
+  atan2(RangePtr<float const>(y), RangePtr<float const>(x),
+        RangePtr<float>(out));
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(atan2(y[i], x[i]), out[i]) << "at " << i;
+  }
+}
+
+TEST_F(ApproxRange, sqrt) {
+  sqrt(RangePtr<float const>(in), RangePtr<float>(out));
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(sqrt(in[i]), out[i]) << "at " << i;
+  }
+}
+
+TEST_F(ApproxRange, rsqrt) {
+  rsqrt(RangePtr<float const>(in), RangePtr<float>(out));
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(rsqrt(in[i]), out[i]) << "at " << i;
+  }
+}
+
+}  // namespace approx
+}  // namespace math
+}  // namespace etl
@@ -0,0 +1,44 @@
+#ifndef TEST_MATH_BATCH_STORAGE_H
+#define TEST_MATH_BATCH_STORAGE_H
+
+/*
+ * Backing storage for the batch types, for tests that check the batch
+ * kernels against their scalar counterparts.  first(n) views the first n
+ * elements, so one set of storage serves every size a test tries.
+ */
+
+#include <cstddef>
+
+#include "etl/data/range_ptr.h"
+#include "etl/math/batch.h"
+
+namespace etl {
+namespace math {
+
+template <std::size_t N>
+struct Vec3Storage {
+  float x[N], y[N], z[N];
+
+  Vec3fBatch first(std::size_t n) {
+    return Vec3fBatch(etl::data::RangePtr<float>(x).first(n),
+                      etl::data::RangePtr<float>(y).first(n),
+                      etl::data::RangePtr<float>(z).first(n));
+  }
+};
+
+template <std::size_t N>
+struct QuatStorage {
+  float s[N], x[N], y[N], z[N];
+
+  QuatBatch first(std::size_t n) {
+    return QuatBatch(etl::data::RangePtr<float>(s).first(n),
+                     etl::data::RangePtr<float>(x).first(n),
+                     etl::data::RangePtr<float>(y).first(n),
+                     etl::data::RangePtr<float>(z).first(n));
+  }
+};
+
+}  // namespace math
+}  // namespace etl
+
+#endif  // TEST_MATH_BATCH_STORAGE_H
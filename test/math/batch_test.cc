@@ -0,0 +1,187 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/math/affine_transform.h"
+#include "etl/math/batch.h"
+#include "etl/math/quaternion.h"
+
+#include "test/lcg.h"
+#include "test/math/batch_storage.h"
+
+using etl::data::RangePtr;
+using namespace etl::math::affine_transform;
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for the structure-of-arrays batch kernels.
+ *
+ * Every kernel is checked against its scalar counterpart, element by element,
+ * at a range of sizes chosen to exercise the remainder handling around the
+ * kernels' 8- and 16-element strides.
+ */
+
+static constexpr auto tolerance = 1e-5f;
+
+static constexpr std::size_t max_count = 67;
+static constexpr std::size_t counts[] {
+  0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 67,
+};
+
+class BatchTest : public ::testing::Test {
+protected:
+  Vec3Storage<max_count> a, b, out;
+  QuatStorage<max_count> q;
+  float scalars[max_count];
+
+  lcg::Gen32 rng;
+
+  // Deterministic values in [-4, 4).
+  float next() {
+    return static_cast<float>(rng.next() & 0xFFFF) / 8192.f - 4.f;
+  }
+
+  Vec3f next_vec() {
+    auto x = next();
+    auto y = next();
+    auto z = next();
+    return Vec3f{x, y, z};
+  }
+
+  virtual void SetUp() {
+    for (std::size_t i = 0; i < max_count; ++i) {
+      a.first(max_count).set(i, next_vec());
+      b.first(max_count).set(i, next_vec());
+      q.first(max_count).set(i, rotation(next_vec(), next()));
+    }
+  }
+
+  static void expect_near(Vec3f const & expected, Vec3f const & actual,
+                          std::size_t count, std::size_t i) {
+    EXPECT_NEAR(0.f, mag(expected - actual), tolerance)
+      << "count " << count << " index " << i;
+  }
+};
+
+TEST_F(BatchTest, StorageRoundTrip) {
+  auto v = Vec3f{1.f, 2.f, 3.f};
+  a.first(max_count).set(5, v);
+  ASSERT_EQ(v, a.first(max_count).get(5));
+  ASSERT_EQ(1.f, a.x[5]);
+  ASSERT_EQ(2.f, a.y[5]);
+  ASSERT_EQ(3.f, a.z[5]);
+}
+
+TEST_F(BatchTest, MismatchedLengthsAssert) {
+  ASSERT_THROW(Vec3fBatch(RangePtr<float>(a.x).first(4),
+                          RangePtr<float>(a.y).first(4),
+                          RangePtr<float>(a.z).first(5)),
+               std::logic_error);
+}
+
+TEST_F(BatchTest, RotateByOne) {
+  auto u = rotation(Vec3f{1.f, 1.f, 0.f}, 0.5f);
+  for (auto n : counts) {
+    rotate(u, a.first(n), out.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      expect_near(rotate(u, a.first(n).get(i)), out.first(n).get(i), n, i);
+    }
+  }
+}
+
+TEST_F(BatchTest, RotateByMany) {
+  for (auto n : counts) {
+    rotate(q.first(n), a.first(n), out.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      expect_near(rotate(q.first(n).get(i), a.first(n).get(i)),
+                  out.first(n).get(i), n, i);
+    }
+  }
+}
+
+TEST_F(BatchTest, RotateInPlace) {
+  auto u = rotation(Vec3f{0.f, 0.f, 1.f}, 1.f);
+  Vec3f expected[max_count];
+  for (std::size_t i = 0; i < max_count; ++i) {
+    expected[i] = rotate(u, a.first(max_count).get(i));
+  }
+
+  rotate(u, a.first(max_count), a.first(max_count));
+  for (std::size_t i = 0; i < max_count; ++i) {
+    expect_near(expected[i], a.first(max_count).get(i), max_count, i);
+  }
+}
+
+TEST_F(BatchTest, Transform) {
+  auto m = translate(Vec3f{1.f, -2.f, 3.f}) * scale(Vec3f{2.f, 0.5f, 1.f});
+  for (auto n : counts) {
+    transform(m, a.first(n), out.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      expect_near(project(m * augment(a.first(n).get(i))),
+                  out.first(n).get(i), n, i);
+    }
+  }
+}
+
+TEST_F(BatchTest, Normalize) {
+  for (auto n : counts) {
+    normalize(a.first(n), out.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      expect_near(Vec3f(normalized(a.first(n).get(i))),
+                  out.first(n).get(i), n, i);
+    }
+  }
+}
+
+TEST_F(BatchTest, Dot) {
+  for (auto n : counts) {
+    auto r = RangePtr<float>(scalars).first(n);
+    dot(a.first(n), b.first(n), r);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(dot(a.first(n).get(i), b.first(n).get(i)), r[i], tolerance)
+        << "count " << n << " index " << i;
+    }
+  }
+}
+
+TEST_F(BatchTest, Cross) {
+  for (auto n : counts) {
+    cross(a.first(n), b.first(n), out.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      expect_near(cross(a.first(n).get(i), b.first(n).get(i)),
+                  out.first(n).get(i), n, i);
+    }
+  }
+}
+
+TEST_F(BatchTest, Mag) {
+  for (auto n : counts) {
+    auto r = RangePtr<float>(scalars).first(n);
+    mag(a.first(n), r);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(mag(a.first(n).get(i)), r[i], tolerance)
+        << "count " << n << " index " << i;
+    }
+  }
+}
+
+TEST_F(BatchTest, KernelsStayInBounds) {
+  // Write a sentinel just past the end of a short output, and make sure the
+  // remainder handling doesn't touch it.
+  out.x[9] = out.y[9] = out.z[9] = 1234.f;
+  scalars[9] = 1234.f;
+
+  cross(a.first(9), b.first(9), out.first(9));
+  mag(a.first(9), RangePtr<float>(scalars).first(9));
+
+  ASSERT_EQ(1234.f, out.x[9]);
+  ASSERT_EQ(1234.f, out.y[9]);
+  ASSERT_EQ(1234.f, out.z[9]);
+  ASSERT_EQ(1234.f, scalars[9]);
+}
+
+}  // namespace math
+}  // namespace etl
@@ -0,0 +1,167 @@
+/*
+ * Micro-benchmarks for the math templates.
+ *
+ * Each operation is measured twice: "single" runs one operation per call on
+ * values the compiler can't see through, which measures latency and the
+ * quality of the inlined code; "bulk" runs over arrays, which measures
+ * throughput and gives the vectorizer something to work with.
+ *
+ * Output is CSV, as described in test/bench.h.
+ */
+
+#include "etl/math/complex.h"
+#include "etl/math/matrix.h"
+#include "etl/math/quaternion.h"
+#include "etl/math/vector.h"
+
+#include "test/bench.h"
+
+using namespace etl::math;
+
+using Mat4f = Matrix<4, 4, float>;
+
+static constexpr unsigned long single_iterations = 10000000;
+static constexpr unsigned long bulk_iterations = 10000;
+static constexpr unsigned long bulk_count = 1024;
+
+static Vec3f vec3_a[bulk_count], vec3_b[bulk_count], vec3_out[bulk_count];
+static Vec4f vec4_in[bulk_count], vec4_out[bulk_count];
+static Mat4f mat4_in[bulk_count], mat4_out[bulk_count];
+static float scalar_out[bulk_count];
+static Complex<float> complex_a[bulk_count], complex_b[bulk_count],
+                      complex_out[bulk_count];
+
+static void fill_inputs() {
+  for (unsigned long i = 0; i < bulk_count; ++i) {
+    auto f = static_cast<float>(i);
+    vec3_a[i] = Vec3f{f, f + 1, f + 2};
+    vec3_b[i] = Vec3f{2 - f, f * 0.5f, 1};
+    vec4_in[i] = Vec4f{f, -f, 1, 1};
+    mat4_in[i] = Mat4f {
+      {1, f, 0, 0},
+      {0, 1, 0, -f},
+      {f, 0, 2, 0},
+      {0, 0, 0, 1},
+    };
+    complex_a[i] = Complex<float>{f, 1 - f};
+    complex_b[i] = Complex<float>{0.5f, f};
+  }
+}
+
+static void vector_benchmarks() {
+  auto a = Vec3f{1, 2, 3};
+  auto b = Vec3f{4, 5, 6};
+
+  bench::run("vec3f.dot.single", single_iterations, [&] (unsigned long) {
+    bench::keep(dot(bench::opaque(a), bench::opaque(b)));
+  });
+  bench::run("vec3f.cross.single", single_iterations, [&] (unsigned long) {
+    bench::keep(cross(bench::opaque(a), bench::opaque(b)));
+  });
+  bench::run("vec3f.mag.single", single_iterations, [&] (unsigned long) {
+    bench::keep(mag(bench::opaque(a)));
+  });
+
+  bench::run("vec3f.dot.bulk", bulk_iterations, bulk_count,
+             [] (unsigned long) {
+    for (unsigned long i = 0; i < bulk_count; ++i) {
+      scalar_out[i] = dot(vec3_a[i], vec3_b[i]);
+    }
+    bench::keep(scalar_out);
+  });
+  bench::run("vec3f.cross.bulk", bulk_iterations, bulk_count,
+             [] (unsigned long) {
+    for (unsigned long i = 0; i < bulk_count; ++i) {
+      vec3_out[i] = cross(vec3_a[i], vec3_b[i]);
+    }
+    bench::keep(vec3_out);
+  });
+  bench::run("vec3f.mag.bulk", bulk_iterations, bulk_count,
+             [] (unsigned long) {
+    for (unsigned long i = 0; i < bulk_count; ++i) {
+      scalar_out[i] = mag(vec3_a[i]);
+    }
+    bench::keep(scalar_out);
+  });
+}
+
+static void matrix_benchmarks() {
+  auto m = Mat4f {
+    {1, 2, 3, 4},
+    {0, 1, 0, -1},
+    {2, 0, 2, 0},
+    {-3, 1, 4, 1},
+  };
+  auto v = Vec4f{1, 2, 3, 4};
+
+  bench::run("mat4f.mul_mat.single", single_iterations, [&] (unsigned long) {
+    bench::keep(bench::opaque(m) * bench::opaque(m));
+  });
+  bench::run("mat4f.mul_vec.single", single_iterations, [&] (unsigned long) {
+    bench::keep(bench::opaque(m) * bench::opaque(v));
+  });
+
+  bench::run("mat4f.mul_mat.bulk", bulk_iterations, bulk_count,
+             [&] (unsigned long) {
+    auto mm = bench::opaque(m);
+    for (unsigned long i = 0; i < bulk_count; ++i) {
+      mat4_out[i] = mm * mat4_in[i];
+    }
+    bench::keep(mat4_out);
+  });
+  bench::run("mat4f.mul_vec.bulk", bulk_iterations, bulk_count,
+             [&] (unsigned long) {
+    auto mm = bench::opaque(m);
+    for (unsigned long i = 0; i < bulk_count; ++i) {
+      vec4_out[i] = mm * vec4_in[i];
+    }
+    bench::keep(vec4_out);
+  });
+}
+
+static void quaternion_benchmarks() {
+  auto u = rotation(Vec3f{1, 2, 3}, 0.75f);
+  auto p = Vec3f{1, 0, 0};
+
+  bench::run("quat.rotate.single", single_iterations, [&] (unsigned long) {
+    bench::keep(rotate(bench::opaque(u), bench::opaque(p)));
+  });
+
+  bench::run("quat.rotate.bulk", bulk_iterations, bulk_count,
+             [&] (unsigned long) {
+    auto uu = bench::opaque(u);
+    for (unsigned long i = 0; i < bulk_count; ++i) {
+      vec3_out[i] = rotate(uu, vec3_a[i]);
+    }
+    bench::keep(vec3_out);
+  });
+}
+
+static void complex_benchmarks() {
+  auto a = Complex<float>{1, 2};
+  auto b = Complex<float>{3, -1};
+
+  bench::run("complex.mul.single", single_iterations, [&] (unsigned long) {
+    bench::keep(bench::opaque(a) * bench::opaque(b));
+  });
+
+  bench::run("complex.mul.bulk", bulk_iterations, bulk_count,
+             [] (unsigned long) {
+    for (unsigned long i = 0; i < bulk_count; ++i) {
+      complex_out[i] = complex_a[i] * complex_b[i];
+    }
+    bench::keep(complex_out);
+  });
+}
+
+int main() {
+  fill_inputs();
+
+  bench::print_header();
+  vector_benchmarks();
+  matrix_benchmarks();
+  quaternion_benchmarks();
+  complex_benchmarks();
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+#include <cfloat>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "etl/math/approx.h"
+#include "etl/math/quaternion.h"
+#include "etl/math/vector.h"
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for the math templates that call trig and sqrt, with tolerances
+ * derived from the bounds in approx.h rather than from float rounding alone.
+ * The math_tests_etl_trig runner builds these against ETL's approximations;
+ * they hold against the toolchain's functions too.
+ *
+ * The references are computed in double precision.
+ */
+
+// The worst absolute error of a sine or cosine.
+static constexpr float trig_error =
+    approx::sin_max_abs_error > approx::cos_max_abs_error
+        ? approx::sin_max_abs_error
+        : approx::cos_max_abs_error;
+
+// The worst relative error of a square root or reciprocal square root, with
+// a few roundings to spare for the arithmetic around it.
+static constexpr float sqrt_error =
+    float((approx::sqrt_max_ulp > approx::rsqrt_max_ulp
+               ? approx::sqrt_max_ulp
+               : approx::rsqrt_max_ulp) + 4) * FLT_EPSILON;
+
+static Vec3f const inputs[] {
+  Vec3f{1, 2, 3},
+  Vec3f{-0.5f, 4, 0.25f},
+  Vec3f{1e-3f, 2e-3f, -1e-3f},
+  Vec3f{300, -200, 50},
+};
+
+static double reference_mag(Vec3f const & v) {
+  return std::sqrt(double(v.x) * v.x + double(v.y) * v.y + double(v.z) * v.z);
+}
+
+/*
+ * p rotated by angle about axis, by Rodrigues' formula.
+ */
+static Vec3f reference_rotate(Vec3f const & axis, double angle,
+                              Vec3f const & p) {
+  double n = reference_mag(axis);
+  double kx = axis.x / n, ky = axis.y / n, kz = axis.z / n;
+  double c = std::cos(angle), s = std::sin(angle);
+  double d = kx * p.x + ky * p.y + kz * p.z;
+  return Vec3f{
+    float(p.x * c + (ky * p.z - kz * p.y) * s + kx * d * (1 - c)),
+    float(p.y * c + (kz * p.x - kx * p.z) * s + ky * d * (1 - c)),
+    float(p.z * c + (kx * p.y - ky * p.x) * s + kz * d * (1 - c)),
+  };
+}
+
+TEST(EtlTrig, mag) {
+  for (auto const & v : inputs) {
+    double expected = reference_mag(v);
+    EXPECT_NEAR(expected, double(mag(v)), sqrt_error * expected)
+      << "for input " << &v - inputs;
+  }
+}
+
+TEST(EtlTrig, normalized) {
+  for (auto const & v : inputs) {
+    double n = reference_mag(v);
+    auto expected = Vec3f{float(v.x / n), float(v.y / n), float(v.z / n)};
+    EXPECT_NEAR(0.f, mag(expected - Vec3f(normalized(v))), 2 * sqrt_error)
+      << "for input " << &v - inputs;
+  }
+}
+
+TEST(EtlTrig, rotation) {
+  // rotate is quadratic in the quaternion, so an error of trig_error in each
+  // of its four components moves the result by at most about 4 trig_error |p|.
+  // Normalizing the axis adds a sqrt error to the vector part.
+  auto tolerance = 4 * trig_error + 2 * sqrt_error + 16 * FLT_EPSILON;
+
+  for (auto const & axis : inputs) {
+    for (int i = -20; i <= 20; ++i) {
+      auto angle = 0.5f * static_cast<float>(i);
+      auto u = rotation(axis, angle);
+      for (auto const & p : inputs) {
+        EXPECT_NEAR(0.f,
+                    mag(reference_rotate(axis, angle, p) - rotate(u, p)),
+                    tolerance * mag(p))
+          << "about input " << &axis - inputs << " by " << angle
+          << " for input " << &p - inputs;
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace etl
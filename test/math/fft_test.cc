@@ -0,0 +1,219 @@
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/math/complex.h"
+#include "etl/math/fft.h"
+
+#include "test/lcg.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for the FFT engine.
+ *
+ * Transforms are compared against a direct DFT evaluated in double
+ * precision.  The tolerance grows with N, since each output bin sums N
+ * inputs.
+ *
+ * As in complex_test, the constexpr twiddle checks are disabled on Clang,
+ * whose sin and cos builtins aren't constexpr.
+ */
+
+using Cf = Complex<float>;
+
+/*******************************************************************************
+ * Twiddle tables.
+ */
+
+#ifndef __clang__
+  static constexpr TwiddleTable<8, float> twiddles8{};
+  static_assert(twiddles8.size() == 8, "");
+  static_assert(twiddles8[0] == Cf{1, 0}, "");
+  static_assert(real(twiddles8[2]) < 1e-7f && real(twiddles8[2]) > -1e-7f,
+                "w^2 of 8 should be -i");
+  static_assert(imag(twiddles8[2]) == -1, "w^2 of 8 should be -i");
+  static_assert(real(twiddles8[4]) == -1, "w^4 of 8 should be -1");
+#endif
+
+/*******************************************************************************
+ * Helpers.
+ */
+
+static constexpr std::size_t max_n = 1024;
+
+static void direct_dft(RangePtr<Cf const> in, RangePtr<Cf> out) {
+  auto n = in.count();
+  for (std::size_t k = 0; k < n; ++k) {
+    double re = 0, im = 0;
+    for (std::size_t t = 0; t < n; ++t) {
+      double angle = -2 * M_PI * double(k * t % n) / double(n);
+      double xr = real(in[t]), xi = imag(in[t]);
+      re += xr * std::cos(angle) - xi * std::sin(angle);
+      im += xr * std::sin(angle) + xi * std::cos(angle);
+    }
+    out[k] = Cf{float(re), float(im)};
+  }
+}
+
+static float tolerance(std::size_t n) {
+  return 4e-6f * static_cast<float>(n);
+}
+
+class FftTest : public ::testing::Test {
+protected:
+  Cf input[max_n];
+  Cf data[max_n];
+  Cf expected[max_n];
+
+  lcg::Gen32 rng;
+
+  float next() {
+    return static_cast<float>(rng.next() & 0xFFFF) / 32768.f - 1.f;
+  }
+
+  // Fills the first n inputs with noise, copies them to data, and computes
+  // the expected transform.
+  void prepare(std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      auto re = next();
+      auto im = next();
+      input[i] = data[i] = Cf{re, im};
+    }
+    direct_dft(RangePtr<Cf const>(input).first(n),
+               RangePtr<Cf>(expected).first(n));
+  }
+
+  void expect_near(RangePtr<Cf const> expect, RangePtr<Cf const> actual,
+                   float tol) {
+    ASSERT_EQ(expect.count(), actual.count());
+    for (std::size_t i = 0; i < expect.count(); ++i) {
+      EXPECT_NEAR(real(expect[i]), real(actual[i]), tol)
+        << "n " << expect.count() << " bin " << i;
+      EXPECT_NEAR(imag(expect[i]), imag(actual[i]), tol)
+        << "n " << expect.count() << " bin " << i;
+    }
+  }
+
+  void check_forward(std::size_t n) {
+    prepare(n);
+    fft(RangePtr<Cf>(data).first(n));
+    expect_near(RangePtr<Cf const>(expected).first(n),
+                RangePtr<Cf const>(data).first(n),
+                tolerance(n));
+  }
+
+  void check_round_trip(std::size_t n) {
+    prepare(n);
+    fft(RangePtr<Cf>(data).first(n));
+    ifft(RangePtr<Cf>(data).first(n));
+    expect_near(RangePtr<Cf const>(input).first(n),
+                RangePtr<Cf const>(data).first(n),
+                2e-5f);
+  }
+};
+
+/*******************************************************************************
+ * Complex transforms.
+ */
+
+TEST_F(FftTest, Trivial) {
+  check_forward(1);
+  check_forward(2);
+}
+
+TEST_F(FftTest, PowersOfTwo) {
+  // Covers both radix-2 (odd powers) and radix-4 (even powers) paths.
+  for (std::size_t n = 4; n <= max_n; n *= 2) {
+    check_forward(n);
+  }
+}
+
+TEST_F(FftTest, MixedRadix) {
+  for (std::size_t n : {3u, 5u, 6u, 12u, 15u, 48u, 60u, 100u, 360u, 1000u}) {
+    check_forward(n);
+  }
+}
+
+TEST_F(FftTest, RoundTrip) {
+  for (std::size_t n : {8u, 64u, 60u, 1024u}) {
+    check_round_trip(n);
+  }
+}
+
+TEST_F(FftTest, Impulse) {
+  for (std::size_t i = 0; i < 16; ++i) data[i] = Cf{};
+  data[0] = Cf{1, 0};
+  fft(RangePtr<Cf>(data).first(16));
+  for (std::size_t i = 0; i < 16; ++i) {
+    EXPECT_NEAR(1.f, real(data[i]), 1e-6f) << "bin " << i;
+    EXPECT_NEAR(0.f, imag(data[i]), 1e-6f) << "bin " << i;
+  }
+}
+
+TEST_F(FftTest, Linearity) {
+  prepare(256);
+  Cf doubled[256];
+  for (std::size_t i = 0; i < 256; ++i) doubled[i] = data[i] + data[i];
+
+  fft(RangePtr<Cf>(data).first(256));
+  fft(RangePtr<Cf>(doubled));
+  for (std::size_t i = 0; i < 256; ++i) {
+    EXPECT_NEAR(2 * real(data[i]), real(doubled[i]), tolerance(256));
+    EXPECT_NEAR(2 * imag(data[i]), imag(doubled[i]), tolerance(256));
+  }
+}
+
+TEST_F(FftTest, UnsupportedSizeAsserts) {
+  // 7 is not among the supported radices.
+  ASSERT_THROW(fft(RangePtr<Cf>(data).first(7)), std::logic_error);
+}
+
+/*******************************************************************************
+ * Real-input transform, which produces the n/2 + 1 non-redundant bins.
+ */
+
+TEST_F(FftTest, RealInput) {
+  for (std::size_t n : {2u, 8u, 64u, 1024u}) {
+    float real_input[max_n];
+    for (std::size_t i = 0; i < n; ++i) {
+      real_input[i] = next();
+      input[i] = Cf{real_input[i], 0};
+    }
+    direct_dft(RangePtr<Cf const>(input).first(n),
+               RangePtr<Cf>(expected).first(n));
+
+    rfft(RangePtr<float const>(real_input).first(n),
+         RangePtr<Cf>(data).first(n / 2 + 1));
+    expect_near(RangePtr<Cf const>(expected).first(n / 2 + 1),
+                RangePtr<Cf const>(data).first(n / 2 + 1),
+                tolerance(n));
+  }
+}
+
+TEST_F(FftTest, RealInputRoundTrip) {
+  float real_input[256], output[256];
+  for (std::size_t i = 0; i < 256; ++i) real_input[i] = next();
+
+  rfft(RangePtr<float const>(real_input), RangePtr<Cf>(data).first(129));
+  irfft(RangePtr<Cf const>(data).first(129), RangePtr<float>(output));
+
+  for (std::size_t i = 0; i < 256; ++i) {
+    EXPECT_NEAR(real_input[i], output[i], 1e-5f) << "at " << i;
+  }
+}
+
+TEST_F(FftTest, RealInputOutputSizeAsserts) {
+  float real_input[16] {};
+  ASSERT_THROW(rfft(RangePtr<float const>(real_input),
+                    RangePtr<Cf>(data).first(8)),
+               std::logic_error);
+}
+
+}  // namespace math
+}  // namespace etl
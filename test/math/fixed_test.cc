@@ -0,0 +1,178 @@
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "etl/bits.h"
+#include "etl/math/complex.h"
+#include "etl/math/fixed.h"
+#include "etl/math/matrix.h"
+#include "etl/math/quaternion.h"
+#include "etl/math/vector.h"
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for the Fixed<IntBits, FracBits> numeric type, both on its own and
+ * as the element type of the other math templates.
+ */
+
+/*******************************************************************************
+ * Representation.
+ */
+
+static_assert(std::is_same<Fixed<16, 16>::Raw, etl::Int<32>>::value,
+              "Fixed should store exactly IntBits + FracBits.");
+static_assert(std::is_same<Fixed<8, 8>::Raw, etl::Int<16>>::value, "");
+static_assert(std::is_same<Fixed<1, 15>::Raw, etl::Int<16>>::value, "");
+static_assert(sizeof(Fixed<16, 16>) == 4, "");
+
+static_assert(std::is_same<Fixed<8, 8>::Wide, etl::IntFast<32>>::value,
+              "Products should widen to at least twice the storage.");
+
+/*******************************************************************************
+ * Constexpr arithmetic.
+ */
+
+using Q16 = Fixed<16, 16>;
+using Q8 = Fixed<8, 8>;
+
+static constexpr auto one = Q16::from_int(1);
+static constexpr auto half = Q16::from_raw(1 << 15);
+static constexpr auto three = Q16::from_int(3);
+
+static_assert(one.raw() == 1 << 16, "");
+static_assert(half + half == one, "");
+static_assert(three - one - one == one, "");
+static_assert(half * Q16::from_int(2) == one, "");
+static_assert(three / Q16::from_int(2) == one + half, "");
+static_assert(-one == Q16::from_int(-1), "");
+static_assert(half < one, "");
+static_assert(Q16::from_int(-3).to_int() == -3, "");
+
+// Conversion from floating point is for constants only, but must be exact
+// where the value is representable.
+static_assert(Q16::from_float(0.5f) == half, "");
+static_assert(Q16::from_float(-2.25f).raw() == -(9 << 14), "");
+
+// Widening multiply doesn't lose the high half of the product.
+static_assert(Q8::from_int(10) * Q8::from_int(10) == Q8::from_int(100), "");
+
+/*******************************************************************************
+ * Saturation.
+ */
+
+static_assert(Q8::max() + Q8::from_int(1) == Q8::max(),
+              "Addition must saturate upward.");
+static_assert(Q8::min() - Q8::from_int(1) == Q8::min(),
+              "Subtraction must saturate downward.");
+static_assert(Q8::from_int(100) * Q8::from_int(100) == Q8::max(),
+              "Multiplication must saturate on overflow.");
+static_assert(Q8::from_int(-100) * Q8::from_int(100) == Q8::min(), "");
+static_assert(-Q8::min() == Q8::max(),
+              "Negating the most negative value must saturate.");
+
+TEST(Fixed, DivideByZeroAsserts) {
+  Q16 zero = Q16::from_int(0);
+  ASSERT_THROW(one / zero, std::logic_error);
+}
+
+TEST(Fixed, MulRoundsToNearest) {
+  // 3 ulp times a hair over or under one half lands a hair either side of
+  // 1.5 ulp: 98307/65536 and 98301/65536 ulp.  Truncation would give 1 for
+  // both.
+  auto three_ulp = Q16::from_raw(3);
+  auto over_half = Q16::from_raw(0x8001);
+  auto under_half = Q16::from_raw(0x7FFF);
+  EXPECT_EQ(2, (three_ulp * over_half).raw());
+  EXPECT_EQ(1, (three_ulp * under_half).raw());
+  // The same, negated, must round away from and toward zero respectively.
+  EXPECT_EQ(-2, (-three_ulp * over_half).raw());
+  EXPECT_EQ(-1, (-three_ulp * under_half).raw());
+  // 3 ulp times 0.625 is 1.875 ulp.
+  EXPECT_EQ(2, (three_ulp * Q16::from_float(0.625f)).raw());
+}
+
+/*******************************************************************************
+ * As an element type.
+ *
+ * The templates are instantiated with a typed test over float and Fixed so
+ * that a single set of expectations covers both; values are chosen to be
+ * exact in either.
+ */
+
+template <typename T>
+class FixedElement : public ::testing::Test {};
+
+using ElementTypes = ::testing::Types<float, Q16>;
+TYPED_TEST_CASE(FixedElement, ElementTypes);
+
+TYPED_TEST(FixedElement, VectorArithmetic) {
+  using T = TypeParam;
+  using V = Vector<3, T>;
+  auto a = V{T(1), T(2), T(3)};
+  auto b = V{T(4), T(5), T(6)};
+
+  EXPECT_EQ((V{T(5), T(7), T(9)}), a + b);
+  EXPECT_EQ((V{T(-3), T(-3), T(-3)}), a - b);
+  EXPECT_EQ((V{T(2), T(4), T(6)}), a * T(2));
+  EXPECT_EQ(T(32), dot(a, b));
+  EXPECT_EQ((V{T(-3), T(6), T(-3)}), cross(a, b));
+}
+
+TYPED_TEST(FixedElement, MatrixMultiply) {
+  using T = TypeParam;
+  auto a = Matrix<3, 2, T> {
+    {T(4), T(8)},
+    {T(0), T(2)},
+    {T(1), T(6)},
+  };
+  auto b = Matrix<2, 2, T> {
+    {T(5), T(2)},
+    {T(9), T(4)},
+  };
+  auto expected = Matrix<3, 2, T> {
+    {T(92), T(40)},
+    {T(18), T(8)},
+    {T(59), T(26)},
+  };
+  EXPECT_EQ(expected, a * b);
+  EXPECT_EQ(a, Matrix<3, 3, T>::identity() * a);
+}
+
+TYPED_TEST(FixedElement, ComplexMultiply) {
+  using T = TypeParam;
+  auto a = Complex<T>{T(1), T(2)};
+  auto b = Complex<T>{T(3), T(-1)};
+
+  EXPECT_EQ((Complex<T>{T(5), T(5)}), a * b);
+  EXPECT_EQ((Complex<T>{T(1), T(-2)}), conj(a));
+  EXPECT_EQ(T(5), sqmag(a));
+}
+
+TYPED_TEST(FixedElement, QuaternionConjugate) {
+  using T = TypeParam;
+  auto q = quat(T(1), Vector<3, T>{T(1), T(2), T(3)});
+  auto c = conjugate(q);
+
+  EXPECT_EQ(T(1), c.scalar);
+  EXPECT_EQ((Vector<3, T>{T(-1), T(-2), T(-3)}), c.vector);
+}
+
+TYPED_TEST(FixedElement, QuaternionRotate) {
+  using T = TypeParam;
+  // A quarter turn about Z, built from exact components: cos(45deg) isn't
+  // exact, so use the unnormalized (1, 0, 0, 1) and rotate by q p q* / |q|^2.
+  auto q = quat(T(1), Vector<3, T>{T(0), T(0), T(1)});
+  auto p = quat(T(0), Vector<3, T>{T(1), T(0), T(0)});
+  auto r = q * p * conjugate(q);
+
+  EXPECT_EQ(T(0), r.scalar);
+  EXPECT_EQ((Vector<3, T>{T(0), T(2), T(0)}), r.vector)
+    << "Expected the X axis to land on Y, scaled by |q|^2 = 2.";
+}
+
+}  // namespace math
+}  // namespace etl
@@ -0,0 +1,174 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/math/gemm.h"
+#include "etl/math/matrix.h"
+
+#include "test/lcg.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for the blocked matrix multiply and the dynamically-sized matrix
+ * view.
+ *
+ * Every product is compared against a naive triple loop.  Elements are small
+ * integers stored as float, so the sums are exact whatever order the blocked
+ * kernels accumulate in, and we can demand equality rather than nearness.
+ */
+
+static constexpr std::size_t max_dim = 97;
+
+static float storage_a[max_dim * max_dim];
+static float storage_b[max_dim * max_dim];
+static float storage_c[max_dim * max_dim];
+static float storage_expected[max_dim * max_dim];
+
+static void fill(MatrixView<float> m, unsigned seed) {
+  lcg::Gen32 rng(seed);
+  for (std::size_t r = 0; r < m.rows(); ++r) {
+    for (std::size_t c = 0; c < m.cols(); ++c) {
+      m(r, c) = static_cast<float>((rng.next() >> 8) % 7) - 3.f;
+    }
+  }
+}
+
+static void naive_multiply(MatrixView<float const> a,
+                           MatrixView<float const> b,
+                           MatrixView<float> c) {
+  for (std::size_t i = 0; i < a.rows(); ++i) {
+    for (std::size_t j = 0; j < b.cols(); ++j) {
+      float sum = 0;
+      for (std::size_t k = 0; k < a.cols(); ++k) {
+        sum += a(i, k) * b(k, j);
+      }
+      c(i, j) = sum;
+    }
+  }
+}
+
+static MatrixView<float> view(float * storage,
+                              std::size_t rows,
+                              std::size_t cols) {
+  return MatrixView<float>(rows, cols,
+                           RangePtr<float>(storage, rows * cols));
+}
+
+/*
+ * Multiplies random m-by-k and k-by-n matrices using the given number of
+ * threads, and checks the result against naive_multiply.
+ */
+static void check_product(std::size_t m, std::size_t k, std::size_t n,
+                          unsigned threads) {
+  auto a = view(storage_a, m, k);
+  auto b = view(storage_b, k, n);
+  auto c = view(storage_c, m, n);
+  auto expected = view(storage_expected, m, n);
+
+  fill(a, static_cast<unsigned>(m * 3 + k));
+  fill(b, static_cast<unsigned>(k * 5 + n));
+  naive_multiply(a, b, expected);
+
+  multiply(a, b, c, threads);
+
+  for (std::size_t i = 0; i < m; ++i) {
+    for (std::size_t j = 0; j < n; ++j) {
+      ASSERT_EQ(expected(i, j), c(i, j))
+        << m << "x" << k << " * " << k << "x" << n
+        << " with " << threads << " threads, at (" << i << ", " << j << ")";
+    }
+  }
+}
+
+TEST(MatrixView, Indexing) {
+  float data[6] { 1, 2, 3, 4, 5, 6 };
+  MatrixView<float> v(2, 3, data);
+
+  ASSERT_EQ(2u, v.rows());
+  ASSERT_EQ(3u, v.cols());
+  ASSERT_EQ(1.f, v(0, 0));
+  ASSERT_EQ(3.f, v(0, 2));
+  ASSERT_EQ(4.f, v(1, 0));
+  ASSERT_EQ(6.f, v(1, 2));
+
+  v(1, 1) = 42;
+  ASSERT_EQ(42.f, data[4]) << "Views must be row-major over their storage.";
+}
+
+TEST(MatrixView, StorageTooSmallAsserts) {
+  float data[5];
+  ASSERT_THROW((MatrixView<float>(2, 3, data)), std::logic_error);
+}
+
+TEST(MatrixView, FromFixedMatrix) {
+  auto m = Matrix<2, 2, float> {
+    {1, 2},
+    {3, 4},
+  };
+  MatrixView<float> v(m);
+  ASSERT_EQ(2u, v.rows());
+  ASSERT_EQ(2u, v.cols());
+  ASSERT_EQ(3.f, v(1, 0));
+}
+
+TEST(Gemm, ShapeMismatchAsserts) {
+  ASSERT_THROW(multiply(view(storage_a, 4, 5),
+                        view(storage_b, 4, 5),
+                        view(storage_c, 4, 5)),
+               std::logic_error);
+}
+
+TEST(Gemm, Small) {
+  // Smaller than any block; exercises the edge handling alone.
+  check_product(1, 1, 1, 1);
+  check_product(3, 2, 2, 1);
+  check_product(5, 7, 3, 1);
+}
+
+TEST(Gemm, BlockMultiples) {
+  check_product(32, 32, 32, 1);
+  check_product(64, 64, 64, 1);
+}
+
+TEST(Gemm, Ragged) {
+  // Dimensions that aren't multiples of any plausible block or micro-kernel
+  // size, in every position.
+  check_product(97, 33, 65, 1);
+  check_product(33, 97, 17, 1);
+  check_product(17, 65, 97, 1);
+}
+
+TEST(Gemm, Threaded) {
+  check_product(64, 64, 64, 4);
+  check_product(97, 33, 65, 3);
+  // More threads than rows must still work.
+  check_product(5, 7, 3, 8);
+}
+
+TEST(Gemm, FixedSizeProductAgrees) {
+  // Whichever kernel Matrix<R, C, T>::operator* uses at this size, it must
+  // agree with multiply() on the same operands.
+  static Matrix<48, 48, float> a, b;
+  fill(MatrixView<float>(a), 7);
+  fill(MatrixView<float>(b), 11);
+
+  auto c = a * b;
+
+  auto expected = view(storage_expected, 48, 48);
+  multiply(MatrixView<float>(a), MatrixView<float>(b), expected);
+
+  MatrixView<float> cv(c);
+  for (std::size_t i = 0; i < 48; ++i) {
+    for (std::size_t j = 0; j < 48; ++j) {
+      ASSERT_EQ(expected(i, j), cv(i, j)) << "at (" << i << ", " << j << ")";
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace etl
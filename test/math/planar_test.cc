@@ -0,0 +1,160 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/data/range_ptr.h"
+#include "etl/math/complex.h"
+#include "etl/math/planar.h"
+
+using etl::data::RangePtr;
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for planar complex buffers and their kernels.
+ *
+ * Every kernel is compared against the scalar Complex<T> operations, over
+ * lengths chosen to exercise vector remainders.  Inputs are small multiples
+ * of 1/4, so every product and sum is exact in float, and the results don't
+ * depend on how the kernels order their arithmetic.
+ */
+
+using Cf = Complex<float>;
+
+static constexpr std::size_t max_count = 33;
+static constexpr std::size_t counts[] { 0, 1, 3, 4, 7, 8, 9, 16, 17, 33 };
+
+/*
+ * Backing storage for one planar buffer.
+ */
+struct PlanarStorage {
+  float re[max_count], im[max_count];
+
+  PlanarComplex<float> first(std::size_t n) {
+    return PlanarComplex<float>(RangePtr<float>(re).first(n),
+                                RangePtr<float>(im).first(n));
+  }
+};
+
+class PlanarTest : public ::testing::Test {
+protected:
+  Cf interleaved_a[max_count], interleaved_b[max_count];
+  PlanarStorage a, b, out;
+  float scalars[max_count];
+
+  virtual void SetUp() {
+    for (std::size_t i = 0; i < max_count; ++i) {
+      auto k = static_cast<float>(i);
+      interleaved_a[i] = Cf{k - 8, 3 - k / 4};
+      interleaved_b[i] = Cf{2 - k / 2, k - 5};
+    }
+    to_planar(RangePtr<Cf const>(interleaved_a), a.first(max_count));
+    to_planar(RangePtr<Cf const>(interleaved_b), b.first(max_count));
+  }
+};
+
+TEST_F(PlanarTest, ToPlanar) {
+  for (std::size_t i = 0; i < max_count; ++i) {
+    EXPECT_EQ(real(interleaved_a[i]), a.re[i]) << "at " << i;
+    EXPECT_EQ(imag(interleaved_a[i]), a.im[i]) << "at " << i;
+  }
+}
+
+TEST_F(PlanarTest, RoundTrip) {
+  for (auto n : counts) {
+    Cf back[max_count];
+    to_interleaved(a.first(n), RangePtr<Cf>(back).first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(interleaved_a[i], back[i]) << "count " << n << " at " << i;
+    }
+  }
+}
+
+TEST_F(PlanarTest, ElementAccess) {
+  auto p = a.first(max_count);
+  EXPECT_EQ(interleaved_a[5], p.get(5));
+  p.set(5, Cf{1, 2});
+  EXPECT_EQ(1.f, a.re[5]);
+  EXPECT_EQ(2.f, a.im[5]);
+}
+
+TEST_F(PlanarTest, MismatchedLengthsAssert) {
+  ASSERT_THROW(PlanarComplex<float>(RangePtr<float>(a.re).first(4),
+                                    RangePtr<float>(a.im).first(5)),
+               std::logic_error);
+}
+
+TEST_F(PlanarTest, Multiply) {
+  for (auto n : counts) {
+    multiply(a.first(n), b.first(n), out.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(interleaved_a[i] * interleaved_b[i], out.first(n).get(i))
+        << "count " << n << " at " << i;
+    }
+  }
+}
+
+TEST_F(PlanarTest, ConjMultiply) {
+  for (auto n : counts) {
+    conj_multiply(a.first(n), b.first(n), out.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(interleaved_a[i] * conj(interleaved_b[i]),
+                out.first(n).get(i))
+        << "count " << n << " at " << i;
+    }
+  }
+}
+
+TEST_F(PlanarTest, MultiplyInPlace) {
+  multiply(a.first(max_count), b.first(max_count), a.first(max_count));
+  for (std::size_t i = 0; i < max_count; ++i) {
+    EXPECT_EQ(interleaved_a[i] * interleaved_b[i], a.first(max_count).get(i))
+      << "at " << i;
+  }
+}
+
+TEST_F(PlanarTest, Sqmag) {
+  for (auto n : counts) {
+    auto r = RangePtr<float>(scalars).first(n);
+    sqmag(a.first(n), r);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(sqmag(interleaved_a[i]), r[i]) << "count " << n << " at " << i;
+    }
+  }
+}
+
+TEST_F(PlanarTest, Dot) {
+  for (auto n : counts) {
+    auto expected = Cf{};
+    for (std::size_t i = 0; i < n; ++i) {
+      expected = expected + interleaved_a[i] * interleaved_b[i];
+    }
+    EXPECT_EQ(expected, dot(a.first(n), b.first(n))) << "count " << n;
+  }
+}
+
+TEST_F(PlanarTest, ConjDot) {
+  for (auto n : counts) {
+    auto expected = Cf{};
+    for (std::size_t i = 0; i < n; ++i) {
+      expected = expected + interleaved_a[i] * conj(interleaved_b[i]);
+    }
+    EXPECT_EQ(expected, conj_dot(a.first(n), b.first(n))) << "count " << n;
+  }
+}
+
+TEST_F(PlanarTest, KernelsStayInBounds) {
+  out.re[9] = out.im[9] = 1234.f;
+  scalars[9] = 1234.f;
+
+  multiply(a.first(9), b.first(9), out.first(9));
+  sqmag(a.first(9), RangePtr<float>(scalars).first(9));
+
+  EXPECT_EQ(1234.f, out.re[9]);
+  EXPECT_EQ(1234.f, out.im[9]);
+  EXPECT_EQ(1234.f, scalars[9]);
+}
+
+}  // namespace math
+}  // namespace etl
@@ -0,0 +1,200 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "etl/math/batch.h"
+#include "etl/math/matrix.h"
+#include "etl/math/quaternion.h"
+
+#include "test/lcg.h"
+#include "test/math/batch_storage.h"
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for quaternion composition, interpolation and conversion to and from
+ * rotation matrices, in scalar and QuatBatch form.
+ *
+ * Quaternions q and -q describe the same rotation, so rather than comparing
+ * components, these tests compare what the rotations do to each axis.
+ */
+
+static constexpr auto tolerance = 1e-6f;
+
+static void expect_same_rotation(UnitQuaternion<float> const & expected,
+                                 UnitQuaternion<float> const & actual,
+                                 float tol = tolerance) {
+  for (auto p : {Vec3f{1, 0, 0}, Vec3f{0, 1, 0}, Vec3f{0, 0, 1}}) {
+    EXPECT_NEAR(0.f, mag(rotate(expected, p) - rotate(actual, p)), tol);
+  }
+}
+
+static auto const about_z = UVec3f::from_unchecked(Vec3f{0, 0, 1});
+static auto const about_x = UVec3f::from_unchecked(Vec3f{1, 0, 0});
+
+/*******************************************************************************
+ * Scalar forms.
+ */
+
+TEST(UnitQuaternion, compose) {
+  auto a = rotation(about_z, float(M_PI) / 2);
+  auto b = rotation(about_x, float(M_PI) / 3);
+  UnitQuaternion<float> ab = a * b;
+
+  ASSERT_FLOAT_EQ(1.f, norm(ab))
+    << "Composing unit quaternions must yield a unit quaternion.";
+
+  auto p = Vec3f{1, 2, 3};
+  ASSERT_NEAR(0.f, mag(rotate(a, rotate(b, p)) - rotate(ab, p)), tolerance)
+    << "a * b must apply b first, then a.";
+}
+
+TEST(UnitQuaternion, slerp_endpoints) {
+  auto a = rotation(about_z, 0.25f);
+  auto b = rotation(about_x, 1.5f);
+
+  expect_same_rotation(a, slerp(a, b, 0.f));
+  expect_same_rotation(b, slerp(a, b, 1.f));
+}
+
+TEST(UnitQuaternion, slerp_constant_velocity) {
+  auto a = rotation(about_z, 0.f);
+  auto b = rotation(about_z, float(M_PI) / 2);
+
+  for (int i = 0; i <= 8; ++i) {
+    float t = static_cast<float>(i) / 8;
+    expect_same_rotation(rotation(about_z, t * float(M_PI) / 2),
+                         slerp(a, b, t));
+  }
+}
+
+TEST(UnitQuaternion, slerp_takes_shortest_path) {
+  auto a = rotation(about_z, 0.f);
+  auto b = rotation(about_z, float(M_PI) / 2);
+  // The same rotation as b, from the other hemisphere: adding a full turn to
+  // the angle negates the quaternion.
+  auto neg_b = rotation(about_z, float(M_PI) / 2 + 2 * float(M_PI));
+
+  expect_same_rotation(slerp(a, b, 0.5f), slerp(a, neg_b, 0.5f));
+}
+
+TEST(UnitQuaternion, slerp_nearly_parallel) {
+  // Interpolating between nearly identical rotations must not divide by the
+  // vanishing sine of the angle between them.
+  auto a = rotation(about_z, 1.f);
+  auto b = rotation(about_z, 1.f + 1e-6f);
+  auto r = slerp(a, b, 0.5f);
+
+  ASSERT_FLOAT_EQ(1.f, norm(r));
+  expect_same_rotation(a, r);
+}
+
+TEST(UnitQuaternion, nlerp) {
+  auto a = rotation(about_z, 0.f);
+  auto b = rotation(about_z, float(M_PI) / 2);
+
+  expect_same_rotation(a, nlerp(a, b, 0.f));
+  expect_same_rotation(b, nlerp(a, b, 1.f));
+
+  auto mid = nlerp(a, b, 0.5f);
+  ASSERT_FLOAT_EQ(1.f, norm(mid));
+  // At the midpoint, nlerp and slerp agree exactly by symmetry.
+  expect_same_rotation(slerp(a, b, 0.5f), mid);
+}
+
+TEST(UnitQuaternion, to_matrix) {
+  auto u = rotation(Vec3f{1, 2, 3}, 0.75f);
+  Matrix<3, 3, float> m = to_matrix(u);
+
+  // Rounding error grows with the length of p, so the tolerance is relative.
+  for (auto p : {Vec3f{1, 0, 0}, Vec3f{0, 1, 0}, Vec3f{0, 0, 1},
+                 Vec3f{-2, 5, 0.5f}}) {
+    ASSERT_NEAR(0.f, mag(rotate(u, p) - m * p), 1e-5f * mag(p));
+  }
+}
+
+TEST(UnitQuaternion, from_matrix_round_trip) {
+  // Cover each branch of the trace-based extraction: small angles (large
+  // trace) and rotations near pi about each axis (negative trace).
+  auto cases = {
+    rotation(Vec3f{1, 2, 3}, 0.1f),
+    rotation(about_x, 3.1f),
+    rotation(UVec3f::from_unchecked(Vec3f{0, 1, 0}), 3.1f),
+    rotation(about_z, 3.1f),
+  };
+  for (auto const & u : cases) {
+    expect_same_rotation(u, from_matrix(to_matrix(u)));
+  }
+}
+
+/*******************************************************************************
+ * QuatBatch forms, checked element by element against the scalar forms at
+ * sizes around the kernels' strides.
+ */
+
+// The kernels may reassociate, so allow the same slack as batch_test does.
+static constexpr auto batch_tolerance = 1e-5f;
+
+static constexpr std::size_t max_count = 33;
+static constexpr std::size_t counts[] { 0, 1, 7, 8, 9, 16, 17, 33 };
+
+class QuatBatchTest : public ::testing::Test {
+protected:
+  QuatStorage<max_count> a, b, result;
+  lcg::Gen32 rng;
+
+  // Deterministic values in [-4, 4).
+  float next() {
+    return static_cast<float>(rng.next() & 0xFFFF) / 8192.f - 4.f;
+  }
+
+  virtual void SetUp() {
+    for (std::size_t i = 0; i < max_count; ++i) {
+      auto axis = Vec3f{next(), next(), next()};
+      a.first(max_count).set(i, rotation(axis, next()));
+      axis = Vec3f{next(), next(), next()};
+      b.first(max_count).set(i, rotation(axis, next()));
+    }
+  }
+};
+
+TEST_F(QuatBatchTest, compose) {
+  for (auto n : counts) {
+    compose(a.first(n), b.first(n), result.first(n));
+    for (std::size_t i = 0; i < n; ++i) {
+      SCOPED_TRACE(testing::Message() << "count " << n << " index " << i);
+      expect_same_rotation(a.first(n).get(i) * b.first(n).get(i),
+                           result.first(n).get(i), batch_tolerance);
+    }
+  }
+}
+
+TEST_F(QuatBatchTest, slerp) {
+  for (auto t : {0.f, 0.3f, 1.f}) {
+    for (auto n : counts) {
+      slerp(a.first(n), b.first(n), t, result.first(n));
+      for (std::size_t i = 0; i < n; ++i) {
+        SCOPED_TRACE(testing::Message() << "count " << n << " index " << i);
+        expect_same_rotation(slerp(a.first(n).get(i), b.first(n).get(i), t),
+                             result.first(n).get(i), batch_tolerance);
+      }
+    }
+  }
+}
+
+TEST_F(QuatBatchTest, nlerp) {
+  for (auto t : {0.f, 0.3f, 1.f}) {
+    for (auto n : counts) {
+      nlerp(a.first(n), b.first(n), t, result.first(n));
+      for (std::size_t i = 0; i < n; ++i) {
+        SCOPED_TRACE(testing::Message() << "count " << n << " index " << i);
+        expect_same_rotation(nlerp(a.first(n).get(i), b.first(n).get(i), t),
+                             result.first(n).get(i), batch_tolerance);
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace etl
@@ -0,0 +1,167 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "etl/math/matrix.h"
+#include "etl/math/vector.h"
+
+namespace etl {
+namespace math {
+
+/*
+ * Tests for the Vec4f and Matrix<4, 4, float> specializations.
+ *
+ * These types may use SIMD storage and kernels at runtime, while constant
+ * evaluation necessarily takes a scalar path.  So the pattern here is to
+ * evaluate each operation both ways and require identical results.  Inputs
+ * are small integers so that the results are exact regardless of the order
+ * in which a kernel happens to sum.
+ */
+
+/*
+ * Forces a value through memory, so that operations on the result can't be
+ * evaluated at compile time.
+ */
+template <typename T>
+static T at_runtime(T v) {
+  asm volatile("" : : "g"(&v) : "memory");
+  return v;
+}
+
+using Mat4f = Matrix<4, 4, float>;
+
+static_assert(sizeof(Vec4f) == 4 * sizeof(float),
+              "Vec4f must stay tightly packed whatever its storage.");
+static_assert(sizeof(Mat4f) == 16 * sizeof(float),
+              "Mat4f must stay tightly packed whatever its storage.");
+
+static constexpr auto u = Vec4f{1.f, 2.f, 3.f, 4.f};
+static constexpr auto v = Vec4f{5.f, -6.f, 7.f, -8.f};
+
+static constexpr auto m = Mat4f {
+  {1.f, 2.f, 3.f, 4.f},
+  {0.f, 1.f, 0.f, -1.f},
+  {2.f, 0.f, 2.f, 0.f},
+  {-3.f, 1.f, 4.f, 1.f},
+};
+
+static constexpr auto n = Mat4f {
+  {0.f, 1.f, 0.f, 0.f},
+  {1.f, 0.f, 0.f, 0.f},
+  {0.f, 0.f, 2.f, 0.f},
+  {1.f, 1.f, 1.f, 1.f},
+};
+
+/*******************************************************************************
+ * Static tests, so that a SIMD specialization can't quietly lose constexpr.
+ */
+
+static_assert(u + v == Vec4f{6.f, -4.f, 10.f, -4.f}, "");
+static_assert(u - v == Vec4f{-4.f, 8.f, -4.f, 12.f}, "");
+static_assert(u * 2.f == Vec4f{2.f, 4.f, 6.f, 8.f}, "");
+static_assert(parallel_mul(u, v) == Vec4f{5.f, -12.f, 21.f, -32.f}, "");
+static_assert(dot(u, v) == -18.f, "");
+static_assert(m * u == Vec4f{30.f, -2.f, 8.f, 15.f}, "");
+static_assert(get<3, 0>(transposed(m)) == 4.f, "");
+static_assert(get<0, 0>(m * n) == 6.f, "");
+
+/*******************************************************************************
+ * Runtime versus compile-time agreement.
+ */
+
+TEST(Vec4fSimd, add) {
+  constexpr auto expected = u + v;
+  ASSERT_EQ(expected, at_runtime(u) + at_runtime(v));
+}
+
+TEST(Vec4fSimd, sub) {
+  constexpr auto expected = u - v;
+  ASSERT_EQ(expected, at_runtime(u) - at_runtime(v));
+}
+
+TEST(Vec4fSimd, neg) {
+  constexpr auto expected = -u;
+  ASSERT_EQ(expected, -at_runtime(u));
+}
+
+TEST(Vec4fSimd, scalar_mul) {
+  constexpr auto expected = 3.f * u;
+  ASSERT_EQ(expected, at_runtime(3.f) * at_runtime(u));
+}
+
+TEST(Vec4fSimd, scalar_div) {
+  constexpr auto expected = u / 2.f;
+  ASSERT_EQ(expected, at_runtime(u) / at_runtime(2.f));
+}
+
+TEST(Vec4fSimd, compound_assign) {
+  constexpr auto expected = (u + v) * 2.f;
+  auto r = at_runtime(u);
+  r += at_runtime(v);
+  r *= 2.f;
+  ASSERT_EQ(expected, r);
+}
+
+TEST(Vec4fSimd, parallel_mul) {
+  constexpr auto expected = parallel_mul(u, v);
+  ASSERT_EQ(expected, parallel_mul(at_runtime(u), at_runtime(v)));
+}
+
+TEST(Vec4fSimd, dot) {
+  constexpr auto expected = dot(u, v);
+  ASSERT_EQ(expected, dot(at_runtime(u), at_runtime(v)));
+}
+
+TEST(Vec4fSimd, horizontal) {
+  ASSERT_EQ(10.f, horizontal(at_runtime(u),
+                             [](float a, float b) { return a + b; }));
+}
+
+TEST(Vec4fSimd, horizontal_associativity) {
+  // horizontal is a left fold.  A pairwise SIMD reduction would give
+  // (1 / 2) / (3 / 4) here instead.
+  ASSERT_EQ(((1.f / 2) / 3) / 4,
+            horizontal(at_runtime(u), [](float a, float b) { return a / b; }));
+}
+
+TEST(Vec4fSimd, equality) {
+  ASSERT_TRUE(at_runtime(u) == u);
+  ASSERT_FALSE(at_runtime(u) == v);
+  ASSERT_TRUE(at_runtime(u) != (Vec4f{1.f, 2.f, 3.f, 5.f}))
+    << "Comparison must consider every lane.";
+}
+
+TEST(Vec4fSimd, field_access_after_arithmetic) {
+  auto r = at_runtime(u) + at_runtime(v);
+  ASSERT_EQ(6.f, r.x);
+  ASSERT_EQ(-4.f, r.y);
+  ASSERT_EQ(10.f, r.z);
+  ASSERT_EQ(-4.f, r.w);
+}
+
+TEST(Mat4fSimd, mul_vector) {
+  constexpr auto expected = m * u;
+  ASSERT_EQ(expected, at_runtime(m) * at_runtime(u));
+}
+
+TEST(Mat4fSimd, mul_matrix) {
+  constexpr auto expected = m * n;
+  ASSERT_EQ(expected, at_runtime(m) * at_runtime(n));
+}
+
+TEST(Mat4fSimd, transposed) {
+  constexpr auto expected = transposed(m);
+  ASSERT_EQ(expected, transposed(at_runtime(m)));
+}
+
+TEST(Mat4fSimd, transposed_twice) {
+  ASSERT_EQ(m, transposed(transposed(at_runtime(m))));
+}
+
+TEST(Mat4fSimd, identity) {
+  ASSERT_EQ(m, at_runtime(Mat4f::identity()) * at_runtime(m));
+  ASSERT_EQ(u, at_runtime(Mat4f::identity()) * at_runtime(u));
+}
+
+}  // namespace math
+}  // namespace etl